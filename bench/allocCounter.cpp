@@ -0,0 +1,58 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    allocCounter.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Count the allocations of the program it is linked with. It replaces the operators new and
+ *                  delete and writes the totals to the standard error when the program ends
+ * 
+ ******************************************************/
+
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+std::atomic<long> g_allocations(0); 
+std::atomic<long> g_allocated_bytes(0); 
+
+/******************************************************
+ * Function name:    countedAlloc
+ * Date created:     17/10/2026
+ * Input arguments:  bytes and alignment (0 the default one)
+ * Purpose:          Count and do the allocation
+ * 
+ ******************************************************/
+void *countedAlloc(std::size_t bytes, std::size_t align){
+    g_allocations.fetch_add(1, std::memory_order_relaxed); 
+    g_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed); 
+    void *p = align == 0 ? std::malloc(bytes == 0 ? 1 : bytes) : std::aligned_alloc(align, (bytes + align - 1) / align * align); 
+    if(p == nullptr){
+        throw std::bad_alloc(); 
+    }
+    return p; 
+}
+
+void *operator new(std::size_t bytes){ return countedAlloc(bytes, 0); }
+void *operator new[](std::size_t bytes){ return countedAlloc(bytes, 0); }
+void *operator new(std::size_t bytes, std::align_val_t align){ return countedAlloc(bytes, static_cast<std::size_t>(align)); }
+void *operator new[](std::size_t bytes, std::align_val_t align){ return countedAlloc(bytes, static_cast<std::size_t>(align)); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+/*It writes the totals when the program ends*/
+struct AllocReport{
+    ~AllocReport(){
+        std::fprintf(stderr, "[ALLOCS] allocations=%ld bytes=%ld\n", g_allocations.load(), g_allocated_bytes.load()); 
+    }
+} g_alloc_report; 
@@ -0,0 +1,31 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchAdmission.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run a sell-out rush with and without the admission control and show how long a client waits 
+#                  until it knows there are no tickets, the clients refused when they arrive and the seats sold
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-5000}
+SHOWINGS=${SHOWINGS:-2}
+RATE=${RATE:-2000}
+SCALE=${SCALE:-0.01}
+OUTPUT=${OUTPUT:-./exec/benchAdmission.out}
+
+for C in 0 1; do
+    $EXEC -L 0 -s $SCALE -a $RATE -c $CLIENTS -p $SHOWINGS -k 64 -x 1 -C $C > $OUTPUT
+    SOLD=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*tickets_sold=([0-9]+).*/\1/')
+    SOLD_OUT=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*sold_out=([0-9]+).*/\1/')
+    WAITLISTED=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*waitlisted=([0-9]+).*/\1/')
+    SECONDS_RUN=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.* seconds=([^ ]+).*/\1/')
+    REFUSED=$(grep "\[LATENCY\] refused " $OUTPUT | sed -E 's/.*(count=.*max_us=[0-9]+).*/\1/')
+    echo "[BENCH] admission=$C seconds=$SECONDS_RUN tickets_sold=$SOLD sold_out=$SOLD_OUT waitlisted=$WAITLISTED refused $REFUSED"
+done
@@ -0,0 +1,29 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchAllocs.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema that counts its allocations in virtual time allocating each request (-P 0)
+#                  and with the pools (-P 1), and show the allocations of each client and of each seat sold
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinemaAllocs}
+CLIENTS=${CLIENTS:-10000}
+SHOWINGS=${SHOWINGS:-1000}
+POINTS=${POINTS:-16}
+SEED=${SEED:-3}
+OUTPUT=${OUTPUT:-./exec/benchAllocs.out}
+
+for POOLED in 0 1; do
+    $EXEC -v -L 0 -x $SEED -c $CLIENTS -p $SHOWINGS -n $POINTS -P $POOLED > $OUTPUT 2>&1
+    ALLOCS=$(grep "\[ALLOCS\]" $OUTPUT | sed -E 's/.*allocations=([0-9]+).*/\1/')
+    BYTES=$(grep "\[ALLOCS\]" $OUTPUT | sed -E 's/.*bytes=([0-9]+).*/\1/')
+    SOLD=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*tickets_sold=([0-9]+).*/\1/')
+    echo "[BENCH] pooled=$POOLED clients=$CLIENTS tickets_sold=$SOLD allocations=$ALLOCS bytes=$BYTES allocations/client=$(awk "BEGIN{print $ALLOCS / $CLIENTS}") allocations/ticket=$(awk "BEGIN{print $ALLOCS / $SOLD}")"
+done
@@ -0,0 +1,38 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchCinema.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema until every client ends with the configuration of the environment, 
+#                  show the throughput and the latency of each phase and write them in RESULTS
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-10000}
+WORKERS=${WORKERS:-0}
+SHOWINGS=${SHOWINGS:-1}
+SALE_POINTS=${SALE_POINTS:-3}
+ARRIVAL_RATE=${ARRIVAL_RATE:-0}
+TICKET_OFFICE_MS=${TICKET_OFFICE_MS:-400}
+SALE_POINT_MS=${SALE_POINT_MS:-1300}
+REPLENISH_MS=${REPLENISH_MS:-900}
+SCALE=${SCALE:-0}
+VIRTUAL=${VIRTUAL:-0}
+RESULTS=${RESULTS:-./exec/benchCinema.json}
+ARRIVALS=${ARRIVALS:-fixed}
+DISTRIBUTIONS=${DISTRIBUTIONS:-uniform:1:5/uniform:1:9/uniform:1:9}
+SEED=${SEED:-1}
+
+OPTIONS="-c $CLIENTS -w $WORKERS -p $SHOWINGS -n $SALE_POINTS -a $ARRIVAL_RATE -T $TICKET_OFFICE_MS -S $SALE_POINT_MS -R $REPLENISH_MS -s $SCALE -o $RESULTS -A $ARRIVALS -D $DISTRIBUTIONS -x $SEED"
+if [ "$VIRTUAL" = "1" ]; then
+    OPTIONS="$OPTIONS -v"
+fi
+
+$EXEC $OPTIONS | grep -E "\[SUMMARY\]|\[LATENCY\]"
+echo "Results written in $RESULTS"
@@ -0,0 +1,21 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchClients.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema without delays for 1k, 10k and 100k clients 
+#                  and show the throughput and the peak of memory of each run
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+WORKERS=${WORKERS:-0}
+
+for clients in 1000 10000 100000; do
+    $EXEC -c $clients -w $WORKERS -s 0 | grep "\[SUMMARY\]"
+done
@@ -0,0 +1,39 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchCoroutines.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema in virtual time with a thread per client and with coroutines, and show
+#                  the peak memory and the time of each run. The threaded mode stops at THREADED_MAX clients
+#
+#******************************************************
+
+THREADED=${THREADED:-./exec/cinema}
+CORO=${CORO:-./exec/cinemaCoro}
+CLIENTS=${CLIENTS:-"10000 100000 1000000"}
+THREADED_MAX=${THREADED_MAX:-100000}
+SHOWINGS=${SHOWINGS:-1000}
+POINTS=${POINTS:-64}
+SEED=${SEED:-1}
+OUTPUT=${OUTPUT:-./exec/benchCoroutines.out}
+
+run(){
+    START=$(date +%s%N)
+    $1 -v -L 0 -a 0 -x $SEED -c $2 -p $SHOWINGS -n $POINTS > $OUTPUT
+    MS=$(( ($(date +%s%N) - START) / 1000000 ))
+    RSS=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*peak_rss_kb=([0-9]+).*/\1/')
+    SOLD=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*tickets_sold=([0-9]+).*/\1/')
+    echo "[BENCH] mode=$3 clients=$2 showings=$SHOWINGS sale_points=$POINTS wall_ms=$MS peak_rss_kb=$RSS tickets_sold=$SOLD"
+}
+
+for C in $CLIENTS; do
+    if [ $C -le $THREADED_MAX ]; then
+        run $THREADED $C threads
+    fi
+    run $CORO $C coroutines
+done
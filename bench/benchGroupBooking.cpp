@@ -0,0 +1,148 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchGroupBooking.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the group orders. The ticket offices hold and release seats of single clients
+ *                  mixed with group orders of several showings, with the locks of each showing taken in order
+ *                  and with one lock for the whole inventory. It shows the throughput of both kinds of orders,
+ *                  the latency of the single ones and checks that no seat is lost
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Inventory.h"
+
+#define DEFAULT_SHOWINGS    16
+#define DEFAULT_THREADS     4
+#define DEFAULT_MS          1000        /*duration of each test*/
+#define GROUP_SHOWINGS      3
+#define GROUP_SEATS         4           /*seats of each showing of a group*/
+#define ROWS                6           /*the halls of the cinema*/
+#define COLS                12
+#define PREFILLED           36          /*seats already sold in each showing*/
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    benchMix
+ * Date created:     17/10/2026
+ * Input arguments:  showings, ticket offices, ms, fraction of group orders and if one lock covers the inventory
+ * Purpose:          Each ticket office holds the seats of an order and releases them as a rejected payment.
+ *                   A group order holds GROUP_SEATS seats in GROUP_SHOWINGS consecutive showings or none
+ * 
+ ******************************************************/
+void benchMix(int showings, int offices, int ms, double share, bool global){
+    Inventory inventory; 
+    std::vector<int> prefilled; 
+    for(int s = 1; s <= showings; s++){
+        inventory.addShowing(s, ROWS, COLS); 
+        inventory.allocate(s, PREFILLED, prefilled); 
+    }
+    std::mutex global_mutex; 
+    std::atomic<bool> stop(false); 
+    std::vector<long> groups(offices, 0), groups_refused(offices, 0), singles(offices, 0); 
+    std::vector<std::vector<long>> latencies(offices); 
+    std::vector<std::thread> threads; 
+
+    for(int t = 0; t < offices; t++){
+        threads.push_back(std::thread([&, t](){
+            std::mt19937_64 rng(t + 1); 
+            std::uniform_real_distribution<double> coin(0, 1); 
+            std::vector<BookingLeg> legs(GROUP_SHOWINGS); 
+            std::vector<int> seats; 
+            while(!stop){
+                int first = 1 + rng() % showings; 
+                if(coin(rng) < share){
+                    for(int k = 0; k < GROUP_SHOWINGS; k++){
+                        legs[k] = {1 + (first - 1 + k) % showings, GROUP_SEATS, {}}; 
+                    }
+                    std::unique_lock<std::mutex> ul(global_mutex, std::defer_lock); 
+                    if(global){
+                        ul.lock(); 
+                    }
+                    if(inventory.holdGroup(legs)){
+                        inventory.releaseGroupHold(legs); 
+                        groups[t]++; 
+                    }else{
+                        groups_refused[t]++; 
+                    }
+                }else{
+                    SteadyClock::time_point begin = SteadyClock::now(); 
+                    {
+                        std::unique_lock<std::mutex> ul(global_mutex, std::defer_lock); 
+                        if(global){
+                            ul.lock(); 
+                        }
+                        seats.clear(); 
+                        if(inventory.hold(first, 2, seats)){
+                            inventory.releaseHold(first, seats); 
+                        }
+                    }
+                    latencies[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - begin).count()); 
+                    singles[t]++; 
+                }
+            }
+        })); 
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms)); 
+    stop = true; 
+    for(unsigned t = 0; t < threads.size(); t++){
+        threads[t].join(); 
+    }
+
+    long total_groups = 0, total_refused = 0, total_singles = 0; 
+    std::vector<long> all; 
+    for(int t = 0; t < offices; t++){
+        total_groups  += groups[t]; 
+        total_refused += groups_refused[t]; 
+        total_singles += singles[t]; 
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end()); 
+    }
+    std::sort(all.begin(), all.end()); 
+    bool lost = false; 
+    for(int s = 1; s <= showings; s++){
+        lost = lost || inventory.getHeld(s) != 0 || inventory.getFree(s) != ROWS * COLS - PREFILLED; 
+    }
+    double seconds = ms / 1000.0; 
+    std::cout << BOLDWHITE << "[BENCH] " << (global ? "one lock" : "ordered locks") << RESET << ": offices=" << offices
+              << " group_share=" << share << " groups/s=" << total_groups / seconds << " groups_refused=" << total_refused
+              << " singles/s=" << total_singles / seconds
+              << " single_p50_ns=" << (all.empty() ? 0 : all[all.size() / 2])
+              << " single_p99_ns=" << (all.empty() ? 0 : all[all.size() * 99 / 100])
+              << " seats_lost=" << (lost ? "yes" : "no") << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [showings] [ticket offices] [ms]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    int showings = argc > 1 ? std::atoi(argv[1]) : DEFAULT_SHOWINGS; 
+    int offices  = argc > 2 ? std::atoi(argv[2]) : DEFAULT_THREADS; 
+    int ms       = argc > 3 ? std::atoi(argv[3]) : DEFAULT_MS; 
+    double shares[] = {0, 0.1, 0.5}; 
+
+    for(double share : shares){
+        benchMix(showings, offices, ms, share, false); 
+        benchMix(showings, offices, ms, share, true); 
+    }
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,29 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchHandoff.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Compare the handoff of a turn through a condition variable shared by every waiter and 
+#                  through a WaitSlot for each one. Then run the cinema without delays with more and more 
+#                  clients and show the context switches of each client
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-"1000 10000 100000"}
+SHOWINGS=${SHOWINGS:-4}
+OUTPUT=${OUTPUT:-./exec/benchHandoff.out}
+
+./exec/benchWaitSlot
+for N in $CLIENTS; do
+    $EXEC -L 0 -s 0 -a 0 -c $N -p $SHOWINGS -k 64 -x 1 -C 0 > $OUTPUT
+    SWITCHES=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*context_switches=([0-9]+).*/\1/')
+    PER_CLIENT=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*csw_per_client=([^ ]+).*/\1/')
+    SECONDS_RUN=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.* seconds=([^ ]+).*/\1/')
+    echo "[BENCH] clients=$N seconds=$SECONDS_RUN context_switches=$SWITCHES csw_per_client=$PER_CLIENT"
+done
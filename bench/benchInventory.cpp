@@ -0,0 +1,127 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchInventory.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Scaling benchmark of the inventory. Threads sell and release seats of random 
+ *                  showings with a lock per showing and with one global lock like g_sem_seats
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Inventory.h"
+
+#define DEFAULT_OPERATIONS  200000
+#define ROWS                20
+#define COLS                30
+
+typedef std::chrono::steady_clock Clock; 
+
+/******************************************************
+ * Class name:       GlobalLockInventory
+ * Date created:     17/10/2026
+ * Input arguments:  number of showings
+ * Purpose:          The same seat maps behind one lock, the design before the inventory
+ * 
+ ******************************************************/
+class GlobalLockInventory{
+    private:
+        std::vector<SeatMap*>   showings; 
+        std::mutex              mutex_; 
+
+    public:
+        GlobalLockInventory(int n){
+            for(int i = 0; i < n; i++){
+                showings.push_back(new SeatMap(ROWS, COLS)); 
+            }
+        }
+        ~GlobalLockInventory(){
+            for(unsigned i = 0; i < showings.size(); i++){
+                delete showings[i]; 
+            }
+        }
+        bool allocate(int showing, int n, std::vector<int> &seats){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return showings[showing - 1]->allocate(n, seats); 
+        }
+        void release(int showing, const std::vector<int> &seats){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            showings[showing - 1]->release(seats); 
+        }
+}; 
+
+/******************************************************
+ * Function name:    run
+ * Date created:     17/10/2026
+ * Input arguments:  inventory, number of showings, threads and operations per thread
+ * Purpose:          Each thread sells 1 to 4 seats of a random showing and releases them. 
+ *                   It returns the operations per second
+ * 
+ ******************************************************/
+template <typename T>
+double run(T &inventory, int showings, int threads, long operations){
+    std::vector<std::thread> workers; 
+    Clock::time_point start = Clock::now(); 
+
+    for(int t = 0; t < threads; t++){
+        workers.push_back(std::thread([&inventory, showings, operations, t]{
+            std::minstd_rand rng(t + 1); 
+            std::vector<int> seats; 
+            for(long i = 0; i < operations; i++){
+                int showing = rng() % showings + 1; 
+                seats.clear(); 
+                inventory.allocate(showing, rng() % 4 + 1, seats); 
+                inventory.release(showing, seats); 
+            }
+        })); 
+    }
+    for(unsigned t = 0; t < workers.size(); t++){
+        workers[t].join(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1e6; 
+    return threads * operations / seconds; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [operations per thread]
+ * Purpose:          Run the benchmark for 1 to 64 showings and 1 to 16 threads
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long operations    = argc > 1 ? std::atol(argv[1]) : DEFAULT_OPERATIONS; 
+    int  showings[4]   = {1, 4, 16, 64}; 
+    int  threads[5]    = {1, 2, 4, 8, 16}; 
+
+    std::cout << BOLDWHITE << "[BENCH] " << std::thread::hardware_concurrency() << " cores, sales+releases per second" << RESET << std::endl; 
+    for(int s = 0; s < 4; s++){
+        for(int t = 0; t < 5; t++){
+            Inventory inventory; 
+            for(int i = 1; i <= showings[s]; i++){
+                inventory.addShowing(i, ROWS, COLS); 
+            }
+            GlobalLockInventory global(showings[s]); 
+
+            double striped = run(inventory, showings[s], threads[t], operations / threads[t]); 
+            double single  = run(global, showings[s], threads[t], operations / threads[t]); 
+            std::cout << BOLDWHITE << "[BENCH] showings " << showings[s] << " threads " << threads[t] << RESET 
+                      << ": lock per showing " << static_cast<long>(striped) << " ops/s, global lock " 
+                      << static_cast<long>(single) << " ops/s" << std::endl; 
+        }
+    }
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,169 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchJournal.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the journal. It measures the latency of the commits with several threads in each
+ *                  durability mode, and the time to recover millions of records with and without snapshots
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Journal.h"
+
+#define DEFAULT_FILE        "exec/benchJournal.bin"
+#define DEFAULT_THREADS     8
+#define DEFAULT_COMMITS     500         /*commits of each thread in the latency test*/
+#define DEFAULT_RECORDS     4000000     /*records of the recovery test*/
+#define RECORDS_PER_COMMIT  4           /*a sale of three seats and its payment*/
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    removeJournal
+ * Date created:     17/10/2026
+ * Input arguments:  file of the journal
+ * Purpose:          Remove the journal and its snapshot
+ * 
+ ******************************************************/
+void removeJournal(std::string file){
+    std::remove(file.c_str()); 
+    std::remove((file + ".snap").c_str()); 
+}
+
+/******************************************************
+ * Function name:    sale
+ * Date created:     17/10/2026
+ * Input arguments:  records and number of the sale
+ * Purpose:          Fill the records of a sale of three seats and its payment
+ * 
+ ******************************************************/
+void sale(JournalRecord *records, long i){
+    for(int k = 0; k < RECORDS_PER_COMMIT - 1; k++){
+        records[k] = {0, J_SEAT_SOLD, 0, {static_cast<int>(i % 1000) + 1, static_cast<int>((i * 3 + k) % 72), 0}, 0}; 
+    }
+    records[RECORDS_PER_COMMIT - 1] = {0, J_PAYMENT, 0, {static_cast<int>(i), 1, 1}, 0}; 
+}
+
+/******************************************************
+ * Function name:    benchCommits
+ * Date created:     17/10/2026
+ * Input arguments:  file, durability, window of the group commit, threads and commits of each thread
+ * Purpose:          Commit the sales from every thread and show the commits per second, the percentiles
+ *                   of the latency and the commits that share each sync
+ * 
+ ******************************************************/
+void benchCommits(std::string file, std::string name, int durability, long window_us, int threads, long commits){
+    removeJournal(file); 
+    Journal journal; 
+    JournalState state; 
+    if(!journal.open(file, durability, window_us, 0, state)){
+        std::cout << BOLDWHITE << "[BENCH] ERROR. The journal " << file << " can't be opened" << RESET << std::endl; 
+        std::exit(EXIT_FAILURE); 
+    }
+    std::vector<std::vector<long>> latencies(threads); 
+    std::vector<std::thread> workers; 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int t = 0; t < threads; t++){
+        workers.push_back(std::thread([&journal, &latencies, t, commits](){
+            JournalRecord records[RECORDS_PER_COMMIT]; 
+            for(long i = 0; i < commits; i++){
+                sale(records, t * commits + i); 
+                SteadyClock::time_point begin = SteadyClock::now(); 
+                journal.commit(records, RECORDS_PER_COMMIT); 
+                latencies[t].push_back(std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - begin).count()); 
+            }
+        })); 
+    }
+    for(unsigned t = 0; t < workers.size(); t++){
+        workers[t].join(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e6; 
+    journal.close(); 
+
+    std::vector<long> all; 
+    for(int t = 0; t < threads; t++){
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end()); 
+    }
+    std::sort(all.begin(), all.end()); 
+    long syncs = std::max(1L, journal.getSyncs()); 
+    std::cout << BOLDWHITE << "[BENCH] commit " << name << RESET << ": threads=" << threads << " commits=" << all.size()
+              << " commits/s=" << all.size() / seconds << " p50_us=" << all[all.size() / 2] << " p99_us=" << all[all.size() * 99 / 100]
+              << " max_us=" << all.back() << " syncs=" << journal.getSyncs() << " commits/sync=" << static_cast<double>(all.size()) / syncs << std::endl; 
+    removeJournal(file); 
+}
+
+/******************************************************
+ * Function name:    benchRecovery
+ * Date created:     17/10/2026
+ * Input arguments:  file, records to write and records between two snapshots
+ * Purpose:          Write the records without waiting for the disk and measure the time to recover them
+ * 
+ ******************************************************/
+void benchRecovery(std::string file, long records, long snapshot_every){
+    removeJournal(file); 
+    Journal journal; 
+    JournalState state; 
+    if(!journal.open(file, JOURNAL_ASYNC, 1000, snapshot_every, state)){
+        std::cout << BOLDWHITE << "[BENCH] ERROR. The journal " << file << " can't be opened" << RESET << std::endl; 
+        std::exit(EXIT_FAILURE); 
+    }
+    JournalRecord batch[RECORDS_PER_COMMIT]; 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(long i = 0; i < records / RECORDS_PER_COMMIT; i++){
+        sale(batch, i); 
+        journal.commit(batch, RECORDS_PER_COMMIT); 
+    }
+    double write_s = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e6; 
+    long snapshots = journal.getSnapshots(); 
+    journal.close(); 
+
+    start = SteadyClock::now(); 
+    bool ok = Journal::recover(file, state); 
+    double recover_ms = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e3; 
+    ok = ok && state.lsn == static_cast<unsigned long>(records / RECORDS_PER_COMMIT * RECORDS_PER_COMMIT)
+            && state.approved == records / RECORDS_PER_COMMIT; 
+    std::cout << BOLDWHITE << "[BENCH] recovery " << (snapshot_every > 0 ? "snapshot+tail" : "full replay") << RESET
+              << ": records=" << state.lsn << " write_s=" << write_s << " records/s=" << state.lsn / write_s
+              << " snapshots=" << snapshots << " recover_ms=" << recover_ms << " state " << (ok ? "ok" : "WRONG") << std::endl; 
+    removeJournal(file); 
+    if(!ok){
+        std::exit(EXIT_FAILURE); 
+    }
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [file] [threads] [commits per thread] [records of the recovery]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    std::string file = argc > 1 ? argv[1] : DEFAULT_FILE; 
+    int threads      = argc > 2 ? std::atoi(argv[2]) : DEFAULT_THREADS; 
+    long commits     = argc > 3 ? std::atol(argv[3]) : DEFAULT_COMMITS; 
+    long records     = argc > 4 ? std::atol(argv[4]) : DEFAULT_RECORDS; 
+
+    benchCommits(file, "sync", JOURNAL_SYNC, 0, threads, commits); 
+    benchCommits(file, "group", JOURNAL_GROUP, 0, threads, commits); 
+    benchCommits(file, "group window=200us", JOURNAL_GROUP, 200, threads, commits); 
+    benchCommits(file, "async", JOURNAL_ASYNC, 1000, threads, commits * 100); 
+
+    benchRecovery(file, records, 0); 
+    benchRecovery(file, records, records / 8); 
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,207 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchLedger.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the ledger of the sales. Several threads append millions of sales, then every
+ *                  query is measured on all of them and again while another thread goes on appending
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Ledger.h"
+
+#define DEFAULT_ROWS        100000000L
+#define DEFAULT_PRODUCERS   4
+#define CONCURRENT_ROWS     20000000L   /*rows appended while the queries run*/
+#define REPEATS             5
+#define DAY_SECONDS         14400       /*the sales are spread over four hours*/
+#define TICKET_CENTS        800
+#define FOOD_CENTS          400
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    appendSale
+ * Date created:     17/10/2026
+ * Input arguments:  ledger, number of the sale and total of the sales
+ * Purpose:          Append a sale: one of each three is of tickets at the ticket offices, the rest of food
+ *                   at one of 8 sale points. It gives back its amount
+ * 
+ ******************************************************/
+long appendSale(Ledger &ledger, long i, long total){
+    bool tickets = i % 3 == 0; 
+    int  basket  = 1 + i % 9; 
+    int  amount  = basket * (tickets ? TICKET_CENTS : FOOD_CENTS); 
+    ledger.append(static_cast<unsigned>(i * DAY_SECONDS / total), tickets ? 1 : 2, tickets ? 0 : 1 + i % 8,
+                  tickets ? 1 + i % 16 : 0, basket, amount); 
+    return amount; 
+}
+
+/******************************************************
+ * Function name:    ingest
+ * Date created:     17/10/2026
+ * Input arguments:  ledger, rows and threads
+ * Purpose:          Each thread appends its part of the rows, it shows the cost of each append and the time
+ *                   until every row can be read. It gives back the revenue appended
+ * 
+ ******************************************************/
+long ingest(Ledger &ledger, long rows, int producers){
+    std::vector<std::thread> threads; 
+    std::atomic<long> cents(0); 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int p = 0; p < producers; p++){
+        threads.push_back(std::thread([&, p](){
+            long sum = 0; 
+            for(long i = p; i < rows; i += producers){
+                sum += appendSale(ledger, i, rows); 
+            }
+            cents += sum; 
+        })); 
+    }
+    for(unsigned i = 0; i < threads.size(); i++){
+        threads[i].join(); 
+    }
+    double appended = std::chrono::duration<double>(SteadyClock::now() - start).count(); 
+    ledger.flush(); 
+    double seconds = std::chrono::duration<double>(SteadyClock::now() - start).count(); 
+    std::cout << BOLDWHITE << "[BENCH] ingest" << RESET << ": rows=" << rows << " producers=" << producers
+              << " ns/append=" << appended * 1e9 * producers / rows << " rows/s=" << rows / seconds
+              << " published=" << ledger.getRows() << " MB=" << ledger.getBytes() / (1 << 20) << std::endl; 
+    return cents.load(); 
+}
+
+/******************************************************
+ * Function name:    measure
+ * Date created:     17/10/2026
+ * Input arguments:  name, query and rows of the ledger
+ * Purpose:          Run the query REPEATS times and show the best and the median time and the rows scanned each second
+ * 
+ ******************************************************/
+void measure(std::string name, std::function<long()> query, long rows){
+    std::vector<double> ms; 
+    long result = 0; 
+    for(int r = 0; r < REPEATS; r++){
+        SteadyClock::time_point start = SteadyClock::now(); 
+        result = query(); 
+        ms.push_back(std::chrono::duration<double, std::milli>(SteadyClock::now() - start).count()); 
+    }
+    std::sort(ms.begin(), ms.end()); 
+    std::cout << BOLDWHITE << "[BENCH] " << name << RESET << ": best_ms=" << ms[0] << " median_ms=" << ms[REPEATS / 2]
+              << " Mrows/s=" << rows / ms[0] / 1000.0 << " result=" << result << std::endl; 
+}
+
+/******************************************************
+ * Function name:    revenueOf
+ * Date created:     17/10/2026
+ * Input arguments:  groups of a query
+ * Purpose:          Revenue of every group, to check the group by against the total
+ * 
+ ******************************************************/
+long revenueOf(const std::vector<LedgerGroup> &groups){
+    long cents = 0; 
+    for(unsigned i = 0; i < groups.size(); i++){
+        cents += groups[i].revenue; 
+    }
+    return cents; 
+}
+
+/******************************************************
+ * Function name:    queries
+ * Date created:     17/10/2026
+ * Input arguments:  ledger and revenue appended
+ * Purpose:          Measure each query on every row and check the results
+ * 
+ ******************************************************/
+void queries(Ledger &ledger, long cents){
+    long rows = ledger.getRows(); 
+    LedgerFilter tickets; 
+    tickets.type = 1; 
+    LedgerFilter last_hour; 
+    last_hour.from = DAY_SECONDS - 3600; 
+
+    measure("revenue", [&](){ return ledger.revenue(); }, rows); 
+    measure("revenue tickets", [&](){ return ledger.revenue(tickets); }, rows); 
+    measure("revenue last hour", [&](){ return ledger.revenue(last_hour); }, rows); 
+    measure("by sale point", [&](){ return revenueOf(ledger.groupBy(LEDGER_SALE_POINT)); }, rows); 
+    measure("by minute", [&](){ return revenueOf(ledger.groupBy(LEDGER_MINUTE)); }, rows); 
+    measure("by showing", [&](){ return revenueOf(ledger.groupBy(LEDGER_SHOWING, tickets)); }, rows); 
+    measure("by basket", [&](){ return revenueOf(ledger.groupBy(LEDGER_BASKET)); }, rows); 
+    measure("by showing last hour", [&](){ return revenueOf(ledger.groupBy(LEDGER_SHOWING, last_hour)); }, rows); 
+
+    bool ok = ledger.revenue() == cents && revenueOf(ledger.groupBy(LEDGER_SALE_POINT)) == cents &&
+              revenueOf(ledger.groupBy(LEDGER_MINUTE)) == cents && revenueOf(ledger.groupBy(LEDGER_BASKET)) == cents &&
+              ledger.revenue(tickets) == revenueOf(ledger.groupBy(LEDGER_SHOWING, tickets)) &&
+              static_cast<long>(ledger.groupBy(LEDGER_MINUTE).size()) == DAY_SECONDS / 60; 
+    std::cout << BOLDWHITE << "[BENCH] check" << RESET << ": revenue=" << ledger.revenue() << " appended=" << cents
+              << (ok ? " ok" : " WRONG") << std::endl; 
+}
+
+/******************************************************
+ * Function name:    concurrent
+ * Date created:     17/10/2026
+ * Input arguments:  ledger and rows to append
+ * Purpose:          One thread appends while the main thread runs the group by sale point again and again,
+ *                   each query sees more rows and never waits for the appends
+ * 
+ ******************************************************/
+void concurrent(Ledger &ledger, long rows){
+    std::atomic<bool> done(false); 
+    long before = ledger.getRows(); 
+    double ns = 0; 
+    std::thread producer([&](){
+        SteadyClock::time_point start = SteadyClock::now(); 
+        for(long i = 0; i < rows; i++){
+            appendSale(ledger, i, rows); 
+        }
+        ns = std::chrono::duration<double, std::nano>(SteadyClock::now() - start).count() / rows; 
+        done = true; 
+    }); 
+    std::vector<double> ms; 
+    while(!done){
+        SteadyClock::time_point start = SteadyClock::now(); 
+        ledger.groupBy(LEDGER_SALE_POINT); 
+        ms.push_back(std::chrono::duration<double, std::milli>(SteadyClock::now() - start).count()); 
+    }
+    producer.join(); 
+    ledger.flush(); 
+    std::sort(ms.begin(), ms.end()); 
+    std::cout << BOLDWHITE << "[BENCH] by sale point while appending" << RESET << ": queries=" << ms.size()
+              << " p50_ms=" << (ms.empty() ? 0 : ms[ms.size() / 2]) << " max_ms=" << (ms.empty() ? 0 : ms.back())
+              << " ns/append=" << ns << " rows=" << before << "->" << ledger.getRows() << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [rows] [producers]
+ * Purpose:          Fill the ledger, measure the queries and then the queries during the appends
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long rows     = argc > 1 ? std::atol(argv[1]) : DEFAULT_ROWS; 
+    int producers = argc > 2 ? std::atoi(argv[2]) : DEFAULT_PRODUCERS; 
+
+    Ledger ledger; 
+    ledger.start(); 
+    long cents = ingest(ledger, rows, producers); 
+    queries(ledger, cents); 
+    concurrent(ledger, std::min(rows, CONCURRENT_ROWS)); 
+    ledger.stop(); 
+
+    return EXIT_SUCCESS; 
+}
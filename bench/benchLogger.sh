@@ -0,0 +1,38 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchLogger.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema without delays with each kind of log and show the throughput. 
+#                  The synchronous log is the previous behaviour, each line flushed to std::cout
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-20000}
+WORKERS=${WORKERS:-0}
+SHOWINGS=${SHOWINGS:-4}
+OUTPUT=${OUTPUT:-./exec/benchLogger.out}
+BINARY=${BINARY:-./exec/benchLogger.bin}
+
+OPTIONS="-c $CLIENTS -w $WORKERS -p $SHOWINGS -a 0 -s 0 -b 0"
+
+run(){
+    $EXEC $OPTIONS $2 > $OUTPUT
+    SUMMARY=$(grep "\[SUMMARY\]" $OUTPUT)
+    SECONDS_RUN=$(echo "$SUMMARY" | sed -E 's/.* seconds=([^ ]+).*/\1/')
+    CLIENTS_S=$(echo "$SUMMARY" | sed -E 's/.* clients\/s=([^ ]+).*/\1/')
+    LINES=$(wc -l < $OUTPUT)
+    echo "[BENCH] $1: seconds=$SECONDS_RUN clients/s=$CLIENTS_S lines=$LINES"
+}
+
+run "sync (baseline)"   "-g 0"
+run "async"             "-g 1"
+run "async info"        "-g 1 -L 2"
+run "binary"            "-B $BINARY"
+run "off"               "-L 0"
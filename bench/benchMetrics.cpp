@@ -0,0 +1,102 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchMetrics.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Microbenchmark of the metrics. It measures the cost of increment() and observe()
+ *                  with several threads against a counter shared by every thread
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Metrics.h"
+
+#define DEFAULT_OPS         10000000
+#define DEFAULT_THREADS     4
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    showResult
+ * Date created:     17/10/2026
+ * Input arguments:  name of the test, number of operations and elapsed time
+ * Purpose:          Show the nanoseconds per operation and the operations per second
+ * 
+ ******************************************************/
+void showResult(std::string name, long ops, SteadyClock::duration elapsed){
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(); 
+    std::cout << BOLDWHITE << "[BENCH] " << name << RESET << ": " << ops << " ops, "
+              << ns / ops << " ns/op, " << ops / (ns / 1e9) << " ops/s" << std::endl; 
+}
+
+/******************************************************
+ * Function name:    runThreads
+ * Date created:     17/10/2026
+ * Input arguments:  number of threads, operations of each thread and operation
+ * Purpose:          Run the operation in every thread and return the elapsed time
+ * 
+ ******************************************************/
+template <typename F>
+SteadyClock::duration runThreads(int threads, long ops, F op){
+    std::vector<std::thread> workers; 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int t = 0; t < threads; t++){
+        workers.push_back(std::thread([ops, &op](){
+            for(long i = 0; i < ops; i++){
+                op(i); 
+            }
+        })); 
+    }
+    for(unsigned t = 0; t < workers.size(); t++){
+        workers[t].join(); 
+    }
+    return SteadyClock::now() - start; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [operations per thread] [threads]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long ops    = argc > 1 ? std::atol(argv[1]) : DEFAULT_OPS; 
+    int threads = argc > 2 ? std::atoi(argv[2]) : DEFAULT_THREADS; 
+    long total  = ops * threads; 
+
+    Metrics metrics; 
+    int counter   = metrics.addCounter("bench_total", "Operations"); 
+    int histogram = metrics.addHistogram("bench_us", "Values observed"); 
+    std::atomic<long> shared(0); 
+
+    showResult("shared atomic fetch_add", total, runThreads(threads, ops, [&shared](long){
+        shared.fetch_add(1, std::memory_order_relaxed); 
+    })); 
+    showResult("Metrics::increment", total, runThreads(threads, ops, [&metrics, counter](long){
+        metrics.increment(counter); 
+    })); 
+    showResult("Metrics::observe", total, runThreads(threads, ops, [&metrics, histogram](long i){
+        metrics.observe(histogram, i & 0xFFFF); 
+    })); 
+
+    std::ostringstream out; 
+    metrics.snapshot(out); 
+    bool ok = metrics.getCounter(counter) == total && metrics.getCount(histogram) == total && shared.load() == total; 
+    std::cout << BOLDWHITE << "[BENCH] totals" << RESET << ": " << (ok ? "ok" : "WRONG")
+              << ", snapshot of " << out.str().size() << " bytes" << std::endl; 
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE; 
+}
@@ -0,0 +1,131 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchMpmcQueue.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contention benchmark of the request queues with 1 to 64 producers. It compares 
+ *                  MpmcQueue against the previous pattern (std::queue + mutex + SemCounter)
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/SemCounter.h"
+#include "../include/MpmcQueue.h"
+
+#define DEFAULT_ITEMS       409600
+#define NUM_CONSUMERS       4
+#define CAPACITY            1024
+
+typedef std::chrono::steady_clock Clock; 
+
+/******************************************************
+ * Class name:       LockedQueue
+ * Date created:     17/10/2026
+ * Input arguments:  
+ * Purpose:          Queue guarded by a mutex with a semaphore that counts the requests, 
+ *                   like g_queue_request_sp with g_sem_mutex_access_sp and g_sem_sale_point
+ * 
+ ******************************************************/
+class LockedQueue{
+    private:
+        std::queue<long>    queue; 
+        std::mutex          mutex_; 
+        SemCounter          items; 
+
+    public:
+        LockedQueue(): items(0){}
+        void push(long value){
+            mutex_.lock(); 
+                queue.push(value); 
+            mutex_.unlock(); 
+            items.signal(); 
+        }
+        long pop(){
+            items.wait(); 
+            mutex_.lock(); 
+                long value = queue.front(); 
+                queue.pop(); 
+            mutex_.unlock(); 
+            return value; 
+        }
+}; 
+
+/******************************************************
+ * Function name:    run
+ * Date created:     17/10/2026
+ * Input arguments:  queue, producers and total items
+ * Purpose:          The producers push the items and NUM_CONSUMERS threads pop them. 
+ *                   It returns the items per second and checks that none is lost
+ * 
+ ******************************************************/
+template <typename Q>
+double run(Q &queue, int producers, long items){
+    std::vector<std::thread> threads; 
+    std::vector<long>        sums(NUM_CONSUMERS, 0); 
+    Clock::time_point start = Clock::now(); 
+
+    for(int c = 0; c < NUM_CONSUMERS; c++){
+        threads.push_back(std::thread([&queue, &sums, items, c]{
+            for(long i = 0; i < items / NUM_CONSUMERS; i++){
+                sums[c] += queue.pop(); 
+            }
+        })); 
+    }
+    for(int p = 0; p < producers; p++){
+        threads.push_back(std::thread([&queue, producers, items, p]{
+            for(long i = p; i < items; i += producers){
+                queue.push(i); 
+            }
+        })); 
+    }
+    for(unsigned t = 0; t < threads.size(); t++){
+        threads[t].join(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1e6; 
+
+    long total = 0; 
+    for(int c = 0; c < NUM_CONSUMERS; c++){
+        total += sums[c]; 
+    }
+    if(total != items * (items - 1) / 2){
+        std::cout << BOLDRED << "[BENCH] ERROR. Items lost or repeated" << RESET << std::endl; 
+    }
+    return items / seconds; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [items]
+ * Purpose:          Run the benchmark for 1 to 64 producers
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long items = argc > 1 ? std::atol(argv[1]) : DEFAULT_ITEMS; 
+    items     -= items % (64 * NUM_CONSUMERS); 
+
+    std::cout << BOLDWHITE << "[BENCH] " << std::thread::hardware_concurrency() << " cores, " << NUM_CONSUMERS 
+              << " consumers, " << items << " items" << RESET << std::endl; 
+    for(int producers = 1; producers <= 64; producers *= 2){
+        MpmcQueue<long> mpmc(CAPACITY); 
+        LockedQueue     locked; 
+        double lock_free = run(mpmc, producers, items); 
+        double mutexed   = run(locked, producers, items); 
+        std::cout << BOLDWHITE << "[BENCH] producers " << producers << RESET << ": MpmcQueue " 
+                  << static_cast<long>(lock_free) << " items/s, mutex + SemCounter " 
+                  << static_cast<long>(mutexed) << " items/s" << std::endl; 
+    }
+    return EXIT_SUCCESS; 
+}
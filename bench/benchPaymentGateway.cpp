@@ -0,0 +1,80 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchPaymentGateway.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Throughput of the payment gateway as the number of authorizations in flight grows
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/msgRequest.h"
+#include "../include/SemCounter.h"
+#include "../include/PaymentGateway.h"
+
+#define DEFAULT_PAYMENTS    2000
+#define DEFAULT_LATENCY_US  2000
+#define DEFAULT_STARVATION_US 60000000
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    run
+ * Date created:     17/10/2026
+ * Input arguments:  window, latency, distribution and number of payments
+ * Purpose:          Send every payment at once and wait for all the callbacks. It returns the payments per second
+ * 
+ ******************************************************/
+double run(int window, long latency_us, int distribution, int payments){
+    PaymentGateway gateway(window, latency_us, distribution, 0.01, 1, DEFAULT_STARVATION_US); 
+    std::vector<MsgRequestPayment*> requests; 
+    SemCounter done(0); 
+
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int i = 0; i < payments; i++){
+        requests.push_back(new MsgRequestPayment(i, 1)); 
+        gateway.authorize(requests.back(), [&done](bool approved){ done.signal(); }); 
+    }
+    for(int i = 0; i < payments; i++){
+        done.wait(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e6; 
+
+    gateway.stop(); 
+    for(unsigned i = 0; i < requests.size(); i++){
+        delete requests[i]; 
+    }
+    return payments / seconds; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [payments] [latency us]
+ * Purpose:          Run the benchmark for K from 1 to 256 with constant and exponential latency
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    int  payments   = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PAYMENTS; 
+    long latency_us = argc > 2 ? std::atol(argv[2]) : DEFAULT_LATENCY_US; 
+
+    std::cout << BOLDWHITE << "[BENCH] " << payments << " payments, mean latency " << latency_us << " us" << RESET << std::endl; 
+    for(int window = 1; window <= 256; window *= 2){
+        double constant    = run(window, latency_us, LATENCY_CONSTANT, payments); 
+        double exponential = run(window, latency_us, LATENCY_EXPONENTIAL, payments); 
+        std::cout << BOLDWHITE << "[BENCH] K " << window << RESET << ": constant " << static_cast<long>(constant) 
+                  << " payments/s, exponential " << static_cast<long>(exponential) << " payments/s (limit " 
+                  << static_cast<long>(window * 1e6 / latency_us) << ")" << std::endl; 
+    }
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,79 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchPaymentScheduler.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Wait of the payments of tickets and food in the gateway for each ratio of the scheduler
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/msgRequest.h"
+#include "../include/SemCounter.h"
+#include "../include/PaymentGateway.h"
+
+#define DEFAULT_PAYMENTS        4000
+#define DEFAULT_STARVATION_MS   1000
+#define WINDOW                  4
+#define LATENCY_US              500
+#define PAY_TO                  1
+#define PAY_SP                  2
+
+/******************************************************
+ * Function name:    run
+ * Date created:     17/10/2026
+ * Input arguments:  ratio, starvation bound and number of payments
+ * Purpose:          Send at once the same number of payments of each type, so the gateway is saturated, 
+ *                   wait for all of them and show the wait of each type
+ * 
+ ******************************************************/
+void run(int ratio, long starvation_ms, int payments){
+    PaymentGateway gateway(WINDOW, LATENCY_US, LATENCY_EXPONENTIAL, 0, ratio, starvation_ms * 1000); 
+    std::vector<MsgRequestPayment*> requests; 
+    SemCounter done(0); 
+
+    for(int i = 0; i < payments; i++){
+        requests.push_back(new MsgRequestPayment(i, i % 2 == 0 ? PAY_TO : PAY_SP)); 
+        gateway.authorize(requests.back(), [&done](bool approved){ done.signal(); }); 
+    }
+    for(int i = 0; i < payments; i++){
+        done.wait(); 
+    }
+    gateway.stop(); 
+
+    std::cout << BOLDWHITE << "[BENCH] ratio " << ratio << RESET 
+              << ": tickets p50 " << gateway.getWaitPercentile(PAY_TO, 50) / 1000 << " ms p99 " << gateway.getWaitPercentile(PAY_TO, 99) / 1000 
+              << " ms, food p50 " << gateway.getWaitPercentile(PAY_SP, 50) / 1000 << " ms p99 " << gateway.getWaitPercentile(PAY_SP, 99) / 1000 
+              << " ms, starved " << gateway.getStarved() << std::endl; 
+    for(unsigned i = 0; i < requests.size(); i++){
+        delete requests[i]; 
+    }
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [payments] [starvation bound ms]
+ * Purpose:          Run the benchmark for ratios from 1 to 16
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    int  payments      = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PAYMENTS; 
+    long starvation_ms = argc > 2 ? std::atol(argv[2]) : DEFAULT_STARVATION_MS; 
+
+    std::cout << BOLDWHITE << "[BENCH] " << payments << " payments, K " << WINDOW << ", mean latency " << LATENCY_US 
+              << " us, starvation bound " << starvation_ms << " ms" << RESET << std::endl; 
+    for(int ratio = 1; ratio <= 16; ratio *= 2){
+        run(ratio, starvation_ms, payments); 
+    }
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,224 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchPool.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the pool of the requests. It measures a thread that creates requests and the workers
+ *                  that free them with new and delete and with the pool, and the counters of the sale points packed
+ *                  in the same cache lines against one cache line each. It shows the cache misses when the
+ *                  hardware counters can be read
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <queue>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "../include/color.h"
+#include "../include/ObjectPool.h"
+
+#define DEFAULT_REQUESTS    4000000     /*requests of the pool test*/
+#define DEFAULT_WORKERS     4
+#define DEFAULT_UPDATES     20000000    /*updates of each sale point*/
+#define POINTS              8
+#define BATCH               64          /*requests the creator passes to the workers at once*/
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/*A request of the size of a session of a client*/
+struct Request{
+    int     id; 
+    int     showing; 
+    int     seats[16]; 
+    long    created_at; 
+    void   *callback[4]; 
+
+    Request(int i): id(i), showing(0), created_at(0){}
+}; 
+
+/*Counters of a sale point as they were, next to the other sale points*/
+struct PackedPoint{
+    std::atomic<long> sold; 
+}; 
+
+/*Counters of a sale point in their own cache line*/
+struct alignas(64) AlignedPoint{
+    std::atomic<long> sold; 
+}; 
+
+/******************************************************
+ * Function name:    openCacheMisses
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Counter of the cache misses of the process and its threads, -1 if there is none
+ * 
+ ******************************************************/
+int openCacheMisses(){
+    struct perf_event_attr attr; 
+    std::memset(&attr, 0, sizeof(attr)); 
+    attr.type           = PERF_TYPE_HARDWARE; 
+    attr.size           = sizeof(attr); 
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES; 
+    attr.disabled       = 1; 
+    attr.inherit        = 1; 
+    attr.exclude_kernel = 1; 
+    attr.exclude_hv     = 1; 
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0); 
+}
+
+/******************************************************
+ * Function name:    measure
+ * Date created:     17/10/2026
+ * Input arguments:  name, operations and test
+ * Purpose:          Run the test and show the nanoseconds of each operation and the cache misses
+ * 
+ ******************************************************/
+template <typename Test>
+void measure(const char *name, long operations, Test test){
+    int fd = openCacheMisses(); 
+    if(fd >= 0){
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0); 
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); 
+    }
+    SteadyClock::time_point start = SteadyClock::now(); 
+    test(); 
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - start).count(); 
+    std::cout << BOLDWHITE << "[BENCH] " << name << RESET << ": operations=" << operations << " ns_op=" << ns / operations; 
+    long long misses = 0; 
+    if(fd >= 0){
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); 
+        if(read(fd, &misses, sizeof(misses)) == sizeof(misses)){
+            std::cout << " cache_misses_op=" << static_cast<double>(misses) / operations; 
+        }
+        close(fd); 
+    }else{
+        std::cout << " cache_misses_op=n/a"; 
+    }
+    std::cout << std::endl; 
+}
+
+/******************************************************
+ * Function name:    benchRequests
+ * Date created:     17/10/2026
+ * Input arguments:  requests, workers and if the pool is used
+ * Purpose:          One thread creates the requests as the clients are created and the workers destroy them as
+ *                   the sessions end, the requests are passed in batches through a queue
+ * 
+ ******************************************************/
+void benchRequests(long requests, int workers, bool pooled){
+    ObjectPool<Request> pool; 
+    pool.setPooled(pooled); 
+    std::mutex mutex_; 
+    std::condition_variable ready; 
+    std::queue<std::vector<Request*>> batches; 
+    bool done = false; 
+
+    measure(pooled ? "pool" : "new/delete", requests, [&](){
+        std::vector<std::thread> threads; 
+        for(int w = 0; w < workers; w++){
+            threads.push_back(std::thread([&](){
+                while(true){
+                    std::vector<Request*> batch; 
+                    {
+                        std::unique_lock<std::mutex> ul(mutex_); 
+                        ready.wait(ul, [&](){ return done || !batches.empty(); }); 
+                        if(batches.empty()){
+                            return; 
+                        }
+                        batch = std::move(batches.front()); 
+                        batches.pop(); 
+                    }
+                    for(unsigned i = 0; i < batch.size(); i++){
+                        batch[i]->showing = batch[i]->id % POINTS; 
+                        pool.destroy(batch[i]); 
+                    }
+                }
+            })); 
+        }
+        std::vector<Request*> batch; 
+        for(long i = 0; i < requests; i++){
+            batch.push_back(pool.create(static_cast<int>(i))); 
+            if(batch.size() == BATCH){
+                std::lock_guard<std::mutex> lg(mutex_); 
+                batches.push(std::move(batch)); 
+                batch.clear(); 
+                ready.notify_one(); 
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lg(mutex_); 
+            batches.push(std::move(batch)); 
+            done = true; 
+            ready.notify_all(); 
+        }
+        for(unsigned w = 0; w < threads.size(); w++){
+            threads[w].join(); 
+        }
+    }); 
+    std::cout << "        slabs=" << pool.getSlabs() << " live=" << pool.getLive() << std::endl; 
+}
+
+/******************************************************
+ * Function name:    benchPoints
+ * Date created:     17/10/2026
+ * Input arguments:  updates of each sale point
+ * Purpose:          Each thread updates the counter of its own sale point, first with the counters packed and then
+ *                   with one cache line for each sale point
+ * 
+ ******************************************************/
+template <typename Point>
+void benchPoints(const char *name, long updates){
+    Point *points = new Point[POINTS]; 
+    for(int p = 0; p < POINTS; p++){
+        points[p].sold = 0; 
+    }
+    measure(name, updates * POINTS, [&](){
+        std::vector<std::thread> threads; 
+        for(int p = 0; p < POINTS; p++){
+            threads.push_back(std::thread([&, p](){
+                for(long i = 0; i < updates; i++){
+                    points[p].sold.fetch_add(1, std::memory_order_relaxed); 
+                }
+            })); 
+        }
+        for(unsigned t = 0; t < threads.size(); t++){
+            threads[t].join(); 
+        }
+    }); 
+    delete[] points; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [requests] [workers] [updates]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long requests = argc > 1 ? std::atol(argv[1]) : DEFAULT_REQUESTS; 
+    int workers   = argc > 2 ? std::atoi(argv[2]) : DEFAULT_WORKERS; 
+    long updates  = argc > 3 ? std::atol(argv[3]) : DEFAULT_UPDATES; 
+
+    std::cout << "cores=" << std::thread::hardware_concurrency() << std::endl; 
+    benchRequests(requests, workers, false); 
+    benchRequests(requests, workers, true); 
+    benchPoints<PackedPoint>("sale points packed", updates); 
+    benchPoints<AlignedPoint>("sale points aligned", updates); 
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,30 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchSalePoints.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema in virtual time with more and more sale points and show 
+#                  the clients served by the sale points each simulated second
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-5000}
+SHOWINGS=${SHOWINGS:-100}
+POINTS=${POINTS:-"3 4 8 16 32"}
+PAYMENT_WINDOW=${PAYMENT_WINDOW:-64}
+OUTPUT=${OUTPUT:-./exec/benchSalePoints.out}
+
+for N in $POINTS; do
+    $EXEC -v -L 0 -a 0 -c $CLIENTS -p $SHOWINGS -n $N -e $N -k $PAYMENT_WINDOW > $OUTPUT
+    SIMULATED=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*simulated_seconds=([^ ]+).*/\1/')
+    STALLS=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.* stalls=([^ ]+).*/\1/')
+    SERVED=$(grep "\[LATENCY\] sale_point " $OUTPUT | sed -E 's/.*count=([^ ]+).*/\1/')
+    P99=$(grep "\[LATENCY\] sale_point_queue " $OUTPUT | sed -E 's/.*p99_us=([^ ]+).*/\1/')
+    echo "[BENCH] sale_points=$N served=$SERVED simulated_seconds=$SIMULATED served/s=$(awk "BEGIN{print $SERVED / $SIMULATED}") queue_p99_us=$P99 stalls=$STALLS"
+done
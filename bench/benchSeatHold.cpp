@@ -0,0 +1,113 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchSeatHold.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Sales per second of a ticket office that waits for each payment against one that holds 
+ *                   the seats and serves the next client while the payment is in flight
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/msgRequest.h"
+#include "../include/SemCounter.h"
+#include "../include/Inventory.h"
+#include "../include/PaymentGateway.h"
+
+#define DEFAULT_SALES       2000
+#define DEFAULT_LATENCY_US  1000
+#define FAILURE_RATE        0.1
+#define ROWS                1000
+#define COLS                64
+#define PAY_TO              1
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    run
+ * Date created:     17/10/2026
+ * Input arguments:  window of the gateway, latency, number of sales and if the ticket office waits for the payment
+ * Purpose:          One ticket office sells 1 to 6 seats to each client. It returns the sales per second
+ * 
+ ******************************************************/
+double run(int window, long latency_us, int sales, bool blocking){
+    Inventory inventory; 
+    int showing = inventory.addShowing(1, ROWS, COLS); 
+    PaymentGateway gateway(window, latency_us, LATENCY_CONSTANT, FAILURE_RATE, 1, latency_us * sales); 
+    std::vector<MsgRequestPayment*> payments; 
+    std::vector<std::vector<int>> seats(sales); 
+    SemCounter done(0); 
+
+    for(int i = 0; i < sales; i++){
+        payments.push_back(new MsgRequestPayment(i, PAY_TO)); 
+    }
+
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int i = 0; i < sales; i++){
+        if(!inventory.hold(showing, 1 + i % 6, seats[i])){
+            done.signal(); 
+            continue; 
+        }
+        if(blocking){
+            if(gateway.authorize(payments[i]).get()){
+                inventory.confirm(showing, seats[i]); 
+            }else{
+                inventory.releaseHold(showing, seats[i]); 
+            }
+            done.signal(); 
+        }else{
+            std::vector<int> *held = &seats[i]; 
+            gateway.authorize(payments[i], [&inventory, &done, showing, held](bool approved){
+                if(approved){
+                    inventory.confirm(showing, *held); 
+                }else{
+                    inventory.releaseHold(showing, *held); 
+                }
+                done.signal(); 
+            }); 
+        }
+    }
+    for(int i = 0; i < sales; i++){
+        done.wait(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e6; 
+
+    gateway.stop(); 
+    if(inventory.getHeld(showing) != 0){
+        std::cout << RED << "[BENCH] " << inventory.getHeld(showing) << " seats still held" << RESET << std::endl; 
+    }
+    for(unsigned i = 0; i < payments.size(); i++){
+        delete payments[i]; 
+    }
+    return sales / seconds; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [sales] [latency us]
+ * Purpose:          Run the benchmark with the same latency of the payment for K from 1 to 64
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    int  sales      = argc > 1 ? std::atoi(argv[1]) : DEFAULT_SALES; 
+    long latency_us = argc > 2 ? std::atol(argv[2]) : DEFAULT_LATENCY_US; 
+
+    std::cout << BOLDWHITE << "[BENCH] " << sales << " sales, payment latency " << latency_us << " us" << RESET << std::endl; 
+    for(int window = 1; window <= 64; window *= 4){
+        double blocking   = run(window, latency_us, sales, true); 
+        double two_phase  = run(window, latency_us, sales, false); 
+        std::cout << BOLDWHITE << "[BENCH] K " << window << RESET << ": waiting for the payment " << static_cast<long>(blocking) 
+                  << " sales/s, hold and pay " << static_cast<long>(two_phase) << " sales/s (x" << two_phase / blocking << ")" << std::endl; 
+    }
+    return EXIT_SUCCESS; 
+}
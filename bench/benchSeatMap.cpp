@@ -0,0 +1,110 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchSeatMap.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the allocation of blocks of seats in fragmented maps
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/SeatMap.h"
+
+#define DEFAULT_ITERATIONS  200000
+
+typedef std::chrono::steady_clock Clock; 
+
+/******************************************************
+ * Function name:    fragment
+ * Date created:     17/10/2026
+ * Input arguments:  map and percentage of seats sold
+ * Purpose:          Sell random seats one by one so the free seats are scattered
+ * 
+ ******************************************************/
+void fragment(SeatMap &map, int percent_sold){
+    int to_sell = map.getCapacity() * percent_sold / 100; 
+    while(map.getCapacity() - map.getFree() < to_sell){
+        map.allocateSeat(rand() % map.getCapacity()); 
+    }
+}
+
+/******************************************************
+ * Function name:    isBlock
+ * Date created:     17/10/2026
+ * Input arguments:  map and seats given
+ * Purpose:          Check that the seats are adjacent and in the same row
+ * 
+ ******************************************************/
+bool isBlock(SeatMap &map, const std::vector<int> &seats){
+    for(unsigned i = 1; i < seats.size(); i++){
+        if(seats[i] != seats[i - 1] + 1 || seats[i] / map.getCols() != seats[0] / map.getCols()){
+            return false; 
+        }
+    }
+    return true; 
+}
+
+/******************************************************
+ * Function name:    benchAllocate
+ * Date created:     17/10/2026
+ * Input arguments:  size of the hall, percentage sold, size of the group and iterations
+ * Purpose:          Measure allocate + release of a group in a fragmented map
+ * 
+ ******************************************************/
+void benchAllocate(int rows, int cols, int percent_sold, int group, long iterations){
+    SeatMap map(rows, cols); 
+    fragment(map, percent_sold); 
+
+    std::vector<int> seats; 
+    seats.reserve(group); 
+    long splits = 0; 
+
+    Clock::time_point start = Clock::now(); 
+    for(long i = 0; i < iterations; i++){
+        seats.clear(); 
+        map.allocate(group, seats); 
+        if(!isBlock(map, seats)){
+            splits++; 
+        }
+        map.release(seats); 
+    }
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(); 
+
+    std::cout << BOLDWHITE << "[BENCH] " << rows << "x" << cols << " sold " << percent_sold << "%" << RESET 
+              << " group " << group << ": " << ns / iterations << " ns/allocation+release, " 
+              << 100.0 * splits / iterations << "% split" << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [iterations]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long iterations = argc > 1 ? std::atol(argv[1]) : DEFAULT_ITERATIONS; 
+    int  halls[3][2] = {{6, 12}, {40, 100}, {25, 400}}; 
+    int  sold[3]     = {0, 50, 85}; 
+    int  groups[4]   = {1, 2, 4, 8}; 
+    srand(1); 
+
+    for(int h = 0; h < 3; h++){
+        for(int s = 0; s < 3; s++){
+            for(int g = 0; g < 4; g++){
+                benchAllocate(halls[h][0], halls[h][1], sold[s], groups[g], iterations); 
+            }
+        }
+    }
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,98 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchSellOut.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of several ticket offices selling one showing until it is sold out. Each thread
+ *                  is a ticket office that keeps selling 1 to 4 seats and, after the sell out, keeps being asked.
+ *                  It shows the sales each second and checks that no seat is sold twice or left unsold
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Inventory.h"
+
+#define DEFAULT_ROWS        1000
+#define DEFAULT_COLS        1000
+#define MAX_OFFICES         16
+#define REFUSED_AFTER       200000      /*requests each ticket office receives after the sell out*/
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+/******************************************************
+ * Function name:    sellOut
+ * Date created:     17/10/2026
+ * Input arguments:  ticket offices, rows and columns of the hall
+ * Purpose:          The ticket offices sell the showing until it has no seats and then they are refused
+ * 
+ ******************************************************/
+void sellOut(int offices, int rows, int cols){
+    Inventory inventory; 
+    inventory.addShowing(1, rows, cols); 
+    std::vector<std::vector<int>> sold(offices); 
+    std::vector<double> refused_ns(offices, 0); 
+    std::vector<std::thread> threads; 
+
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(int t = 0; t < offices; t++){
+        threads.push_back(std::thread([&, t](){
+            int n = 1 + t % 4; 
+            std::vector<int> &seats = sold[t]; 
+            while(inventory.hold(1, n, seats) || inventory.hold(1, 1, seats)){}
+            SteadyClock::time_point begin = SteadyClock::now(); 
+            std::vector<int> none; 
+            for(int i = 0; i < REFUSED_AFTER; i++){
+                inventory.hold(1, n, none); 
+            }
+            refused_ns[t] = std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - begin).count() / static_cast<double>(REFUSED_AFTER); 
+        })); 
+    }
+    for(unsigned t = 0; t < threads.size(); t++){
+        threads[t].join(); 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count() / 1e6; 
+
+    std::vector<bool> taken(rows * cols, false); 
+    long total = 0, twice = 0; 
+    double refused = 0; 
+    for(int t = 0; t < offices; t++){
+        for(unsigned i = 0; i < sold[t].size(); i++){
+            twice += taken[sold[t][i]] ? 1 : 0; 
+            taken[sold[t][i]] = true; 
+        }
+        total   += sold[t].size(); 
+        refused += refused_ns[t] / offices; 
+    }
+    std::cout << BOLDWHITE << "[BENCH] sell out" << RESET << ": ticket_offices=" << offices << " seats=" << rows * cols
+              << " sold=" << total << " sold_twice=" << twice << " available=" << inventory.getAvailable(1)
+              << " seconds=" << seconds << " seats/s=" << total / seconds << " refused_ns=" << refused << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [rows] [columns]
+ * Purpose:          Run the benchmark with 1, 2, 4, 8 and 16 ticket offices
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    int rows = argc > 1 ? std::atoi(argv[1]) : DEFAULT_ROWS; 
+    int cols = argc > 2 ? std::atoi(argv[2]) : DEFAULT_COLS; 
+
+    std::cout << "cores=" << std::thread::hardware_concurrency() << std::endl; 
+    for(int offices = 1; offices <= MAX_OFFICES; offices *= 2){
+        sellOut(offices, rows, cols); 
+    }
+    return EXIT_SUCCESS; 
+}
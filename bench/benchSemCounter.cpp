@@ -0,0 +1,210 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchSemCounter.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Microbenchmark of the counter semaphore. It measures the handoff latency 
+ *                  and the throughput of SemCounter against the previous implementation
+ *                  (mutex_block unlocked from other thread and 200 ms of sleep in signal)
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/SemCounter.h"
+
+#define DEFAULT_HANDOFFS        100000
+#define DEFAULT_LEGACY_HANDOFFS 10
+
+typedef std::chrono::steady_clock Clock; 
+
+/******************************************************
+ * Class name:       LegacySemCounter
+ * Date created:     17/10/2026
+ * Input arguments:  initial value
+ * Purpose:          Copy of the previous SemCounter, kept only to compare against it
+ * 
+ ******************************************************/
+class LegacySemCounter{
+    private:
+        int value;
+        std::mutex mutex_; 
+        std::mutex mutex_block; 
+
+    public:
+        LegacySemCounter(int v): value(v){}
+        void wait(){
+            mutex_.lock(); 
+            if(--value <=0){
+                mutex_.unlock(); 
+                mutex_block.lock(); 
+                mutex_.lock();
+            }
+            mutex_.unlock(); 
+        }
+        void signal(){
+            mutex_.lock(); 
+            if(++value <= 0){
+                mutex_block.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(200)); 
+            }
+            mutex_.unlock(); 
+        }
+        int getValue(){ return value; }
+};
+
+/******************************************************
+ * Function name:    showResult
+ * Date created:     17/10/2026
+ * Input arguments:  name of the test, number of handoffs and elapsed time
+ * Purpose:          Show the latency per handoff and the handoffs per second
+ * 
+ ******************************************************/
+void showResult(std::string name, long handoffs, Clock::duration elapsed){
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(); 
+    std::cout << BOLDWHITE << "[BENCH] " << name << RESET << ": " << handoffs << " handoffs, " 
+              << ns / handoffs / 1000.0 << " us/handoff, " 
+              << handoffs / (ns / 1e9) << " handoffs/s" << std::endl; 
+}
+
+/******************************************************
+ * Function name:    pingPongLegacy
+ * Date created:     17/10/2026
+ * Input arguments:  number of handoffs
+ * Purpose:          Two threads pass the turn through two legacy semaphores. The old class loses
+ *                   the signal when nobody is blocked yet, so each side waits until the other is blocked
+ * 
+ ******************************************************/
+void pingPongLegacy(long handoffs){
+    LegacySemCounter ping(1), pong(1); 
+    ping.wait();    /*The same priming that blockSem did*/
+    pong.wait(); 
+
+    std::thread partner([&]{
+        for(long i = 0; i < handoffs / 2; i++){
+            ping.wait(); 
+            while(pong.getValue() >= 0){ std::this_thread::yield(); }
+            pong.signal(); 
+        }
+    }); 
+
+    Clock::time_point start = Clock::now(); 
+    for(long i = 0; i < handoffs / 2; i++){
+        while(ping.getValue() >= 0){ std::this_thread::yield(); }
+        ping.signal(); 
+        pong.wait(); 
+    }
+    Clock::duration elapsed = Clock::now() - start; 
+    partner.join(); 
+    showResult("legacy ping-pong", handoffs, elapsed); 
+}
+
+/******************************************************
+ * Function name:    pingPong
+ * Date created:     17/10/2026
+ * Input arguments:  number of handoffs
+ * Purpose:          Two threads pass the turn through two semaphores
+ * 
+ ******************************************************/
+void pingPong(long handoffs){
+    SemCounter ping(0), pong(0); 
+
+    std::thread partner([&]{
+        for(long i = 0; i < handoffs / 2; i++){
+            ping.wait(); 
+            pong.signal(); 
+        }
+    }); 
+
+    Clock::time_point start = Clock::now(); 
+    for(long i = 0; i < handoffs / 2; i++){
+        ping.signal(); 
+        pong.wait(); 
+    }
+    Clock::duration elapsed = Clock::now() - start; 
+    partner.join(); 
+    showResult("ping-pong", handoffs, elapsed); 
+}
+
+/******************************************************
+ * Function name:    producerConsumer
+ * Date created:     17/10/2026
+ * Input arguments:  number of permits and size of the batch of signal(n)
+ * Purpose:          One producer releases permits and one consumer takes them as fast as possible
+ * 
+ ******************************************************/
+void producerConsumer(long permits, int batch){
+    SemCounter sem(0); 
+
+    std::thread consumer([&]{
+        for(long i = 0; i < permits; i++){
+            sem.wait(); 
+        }
+    }); 
+
+    Clock::time_point start = Clock::now(); 
+    for(long i = 0; i < permits; i += batch){
+        if(batch == 1){
+            sem.signal(); 
+        }else{
+            sem.signal(batch); 
+        }
+    }
+    consumer.join(); 
+    Clock::duration elapsed = Clock::now() - start; 
+    showResult("producer-consumer batch " + std::to_string(batch), permits, elapsed); 
+}
+
+/******************************************************
+ * Function name:    tryAndTimeout
+ * Date created:     17/10/2026
+ * Input arguments:  number of operations
+ * Purpose:          Cost of try_wait without contention and accuracy of wait_for on an empty semaphore
+ * 
+ ******************************************************/
+void tryAndTimeout(long ops){
+    SemCounter sem(0); 
+    sem.signal(static_cast<int>(ops)); 
+
+    Clock::time_point start = Clock::now(); 
+    for(long i = 0; i < ops; i++){
+        sem.try_wait(); 
+    }
+    showResult("try_wait uncontended", ops, Clock::now() - start); 
+
+    start = Clock::now(); 
+    bool taken = sem.wait_for(std::chrono::milliseconds(10)); 
+    double ms = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0; 
+    std::cout << BOLDWHITE << "[BENCH] wait_for 10 ms on empty semaphore" << RESET << ": returned " 
+              << (taken ? "true" : "false") << " after " << ms << " ms" << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [handoffs] [legacy handoffs]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long handoffs        = argc > 1 ? std::atol(argv[1]) : DEFAULT_HANDOFFS; 
+    long legacy_handoffs = argc > 2 ? std::atol(argv[2]) : DEFAULT_LEGACY_HANDOFFS; 
+
+    pingPongLegacy(legacy_handoffs); 
+    pingPong(handoffs); 
+    producerConsumer(handoffs, 1); 
+    producerConsumer(handoffs, 16); 
+    tryAndTimeout(handoffs); 
+
+    return EXIT_SUCCESS; 
+}
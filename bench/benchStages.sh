@@ -0,0 +1,37 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchStages.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Resize one stage of the pipeline at a time in virtual time and show the workers, 
+#                  the utilization and the wait in the queues of every stage
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-2000}
+SHOWINGS=${SHOWINGS:-4}
+RATE=${RATE:-5}
+OUTPUT=${OUTPUT:-./exec/benchStages.out}
+
+run(){
+    $EXEC -v -L 0 -a $RATE -c $CLIENTS -p $SHOWINGS -k 16 -x 1 $1 > $OUTPUT
+    SIMULATED=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*simulated_seconds=([^ ]+).*/\1/')
+    echo "[BENCH] $1 simulated_seconds=$SIMULATED"
+    grep "\[STAGE\]" $OUTPUT | sed -E 's/.*\[STAGE\] ([^ ]+) (workers=[0-9]+).*(utilization=[^ ]+) (queue_p50_us=[0-9]+) (queue_p99_us=[0-9]+).*/    \1 \2 \3 \4 \5/'
+}
+
+for N in 2 4 8; do
+    run "-n $N"
+done
+for O in 1 2 4; do
+    run "-O $O"
+done
+for E in 1 2; do
+    run "-e $E -n 8"
+done
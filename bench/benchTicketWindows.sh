@@ -0,0 +1,32 @@
+#!/bin/bash
+#******************************************************
+# Project:         Práctica 3 de Sistemas Operativos II
+#
+# Program name:    benchTicketWindows.sh
+#
+# Author:          María Espinosa Astilleros
+#
+# Date created:    17/10/2026
+#
+# Purpose:         Run the cinema in virtual time with more and more ticket offices for each showing and show 
+#                  the clients served by the ticket offices each simulated second. The sale points are fast 
+#                  so the ticket offices are the bottleneck
+#
+#******************************************************
+
+EXEC=${EXEC:-./exec/cinema}
+CLIENTS=${CLIENTS:-2000}
+SHOWINGS=${SHOWINGS:-8}
+WINDOWS=${WINDOWS:-"1 2 4 8 16"}
+OUTPUT=${OUTPUT:-./exec/benchTicketWindows.out}
+
+for N in $WINDOWS; do
+    $EXEC -v -L 0 -a 0 -c $CLIENTS -p $SHOWINGS -O $N -n 32 -e 32 -S 10 -R 10 -k 256 -l 50 -t 0 > $OUTPUT
+    SIMULATED=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*simulated_seconds=([^ ]+).*/\1/')
+    SOLD=$(grep "\[SUMMARY\]" $OUTPUT | sed -E 's/.*tickets_sold=([0-9]+).*/\1/')
+    SERVED=$(grep "\[LATENCY\] ticket_office " $OUTPUT | sed -E 's/.*count=([0-9]+).*/\1/')
+    LAST=$(grep "\[LATENCY\] ticket_queue " $OUTPUT | sed -E 's/.*max_us=([0-9]+).*/\1/')
+    P99=$(grep "\[LATENCY\] ticket_queue " $OUTPUT | sed -E 's/.*p99_us=([0-9]+).*/\1/')
+    echo "[BENCH] ticket_offices=$N served=$SERVED tickets_sold=$SOLD simulated_seconds=$SIMULATED served/s=$(awk "BEGIN{print $SERVED * 1e6 / $LAST}") queue_p99_us=$P99"
+done
+./exec/benchSellOut
@@ -0,0 +1,204 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    benchTimingWheel.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Benchmark of the wheel of the holds. It measures the cost of arming, cancelling and expiring
+ *                  millions of holds against an ordered map of deadlines, and the latency of the ticket offices
+ *                  while a burst of holds expires at once and their seats go back to the inventory
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Inventory.h"
+#include "../include/TimingWheel.h"
+
+#define DEFAULT_HOLDS       4000000     /*holds of the cost test*/
+#define DEFAULT_BURST       1000000     /*holds that expire at once*/
+#define DEFAULT_OFFICES     4
+#define TICK_US             10000       /*the same tick as the cinema*/
+#define SPREAD_US           5000000L    /*the deadlines are spread over 5 s*/
+#define ROWS                256
+#define COLS                256
+#define BURST_SHOWINGS      16
+
+typedef std::chrono::steady_clock SteadyClock; 
+
+struct Hold{
+    int                 showing; 
+    std::vector<int>    seats; 
+}; 
+
+/******************************************************
+ * Function name:    elapsedNs
+ * Date created:     17/10/2026
+ * Input arguments:  start
+ * Purpose:          Nanoseconds since start
+ * 
+ ******************************************************/
+double elapsedNs(SteadyClock::time_point start){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - start).count(); 
+}
+
+/******************************************************
+ * Function name:    benchCost
+ * Date created:     17/10/2026
+ * Input arguments:  number of holds
+ * Purpose:          Arm every hold, cancel half of them as if their payment arrived and expire the rest.
+ *                   The same with a map ordered by deadline, where each operation is O(log n)
+ * 
+ ******************************************************/
+void benchCost(long holds){
+    std::vector<long> deadlines(holds); 
+    unsigned long seed = 88172645463325252UL; 
+    for(long i = 0; i < holds; i++){
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; 
+        deadlines[i] = static_cast<long>(seed % SPREAD_US); 
+    }
+
+    TimingWheel wheel(TICK_US); 
+    std::vector<unsigned long> handles(holds); 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    for(long i = 0; i < holds; i++){
+        handles[i] = wheel.arm(deadlines[i], reinterpret_cast<void*>(i)); 
+    }
+    double arm_ns = elapsedNs(start) / holds; 
+    start = SteadyClock::now(); 
+    for(long i = 0; i < holds; i += 2){
+        wheel.cancel(handles[i]); 
+    }
+    double cancel_ns = elapsedNs(start) / (holds / 2); 
+    long expired = 0; 
+    start = SteadyClock::now(); 
+    wheel.expire(SPREAD_US, [&expired](void *data){ expired++; }); 
+    double expire_ns = elapsedNs(start) / std::max(1L, expired); 
+    std::cout << BOLDWHITE << "[BENCH] wheel" << RESET << ": holds=" << holds << " arm_ns=" << arm_ns << " cancel_ns=" << cancel_ns
+              << " expire_ns=" << expire_ns << " expired=" << expired << std::endl; 
+
+    std::multimap<long, long> timers; 
+    std::vector<std::multimap<long, long>::iterator> its(holds); 
+    start = SteadyClock::now(); 
+    for(long i = 0; i < holds; i++){
+        its[i] = timers.insert({deadlines[i], i}); 
+    }
+    arm_ns = elapsedNs(start) / holds; 
+    start = SteadyClock::now(); 
+    for(long i = 0; i < holds; i += 2){
+        timers.erase(its[i]); 
+    }
+    cancel_ns = elapsedNs(start) / (holds / 2); 
+    expired = 0; 
+    start = SteadyClock::now(); 
+    while(!timers.empty() && timers.begin()->first <= SPREAD_US){
+        expired++; 
+        timers.erase(timers.begin()); 
+    }
+    expire_ns = elapsedNs(start) / std::max(1L, expired); 
+    std::cout << BOLDWHITE << "[BENCH] ordered map" << RESET << ": holds=" << holds << " arm_ns=" << arm_ns << " cancel_ns=" << cancel_ns
+              << " expire_ns=" << expire_ns << " expired=" << expired << std::endl; 
+}
+
+/******************************************************
+ * Function name:    benchBurst
+ * Date created:     17/10/2026
+ * Input arguments:  holds of the burst, ticket offices and if the burst expires
+ * Purpose:          Each ticket office holds two seats of its own showing, arms the timer and cancels it and
+ *                   releases the seats as a rejected payment. Meanwhile the burst of holds expires on one tick
+ *                   and returns its seats. It shows the percentiles of the latency of the ticket offices
+ * 
+ ******************************************************/
+void benchBurst(long burst, int offices, bool expire){
+    Inventory inventory; 
+    TimingWheel wheel(TICK_US); 
+    for(int i = 0; i < BURST_SHOWINGS + offices; i++){
+        inventory.addShowing(i + 1, ROWS, COLS); 
+    }
+    std::vector<Hold> holds(burst); 
+    for(long i = 0; i < burst; i++){
+        holds[i].showing = 1 + i % BURST_SHOWINGS; 
+        if(inventory.hold(holds[i].showing, 1, holds[i].seats)){
+            wheel.arm(TICK_US, &holds[i]); 
+        }
+    }
+    long armed = wheel.getArmed(); 
+
+    std::atomic<bool> stop(false); 
+    std::vector<std::vector<long>> latencies(offices); 
+    std::vector<std::thread> threads; 
+    for(int t = 0; t < offices; t++){
+        threads.push_back(std::thread([&, t](){
+            int showing = BURST_SHOWINGS + t + 1; 
+            std::vector<int> seats; 
+            while(!stop){
+                SteadyClock::time_point begin = SteadyClock::now(); 
+                seats.clear(); 
+                inventory.hold(showing, 2, seats); 
+                unsigned long hold = wheel.arm(SPREAD_US, nullptr); 
+                wheel.cancel(hold); 
+                inventory.releaseHold(showing, seats); 
+                latencies[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - begin).count()); 
+            }
+        })); 
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); 
+    SteadyClock::time_point start = SteadyClock::now(); 
+    long expired = 0; 
+    if(expire){
+        expired = wheel.expire(TICK_US, [&inventory](void *data){
+            Hold *h = static_cast<Hold*>(data); 
+            inventory.releaseHold(h->showing, h->seats); 
+        }); 
+    }else{
+        std::this_thread::sleep_for(std::chrono::milliseconds(200)); 
+    }
+    double burst_ms = elapsedNs(start) / 1e6; 
+    stop = true; 
+    for(unsigned t = 0; t < threads.size(); t++){
+        threads[t].join(); 
+    }
+
+    std::vector<long> all; 
+    for(int t = 0; t < offices; t++){
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end()); 
+    }
+    std::sort(all.begin(), all.end()); 
+    long free = 0; 
+    for(int s = 1; s <= BURST_SHOWINGS; s++){
+        free += inventory.getFree(s); 
+    }
+    std::cout << BOLDWHITE << "[BENCH] ticket offices " << (expire ? "during a burst" : "without burst") << RESET << ": offices=" << offices
+              << " holds=" << armed << " expired=" << expired << " burst_ms=" << burst_ms << " expire_ns=" << (expired > 0 ? burst_ms * 1e6 / expired : 0)
+              << " seats_back=" << (expire ? free : 0) << " ops=" << all.size() << " p50_ns=" << all[all.size() / 2]
+              << " p99_ns=" << all[all.size() * 99 / 100] << " max_ns=" << all.back() << std::endl; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [holds] [burst] [ticket offices]
+ * Purpose:          Run the benchmarks
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long holds  = argc > 1 ? std::atol(argv[1]) : DEFAULT_HOLDS; 
+    long burst  = argc > 2 ? std::atol(argv[2]) : DEFAULT_BURST; 
+    int offices = argc > 3 ? std::atoi(argv[3]) : DEFAULT_OFFICES; 
+
+    benchCost(holds); 
+    benchBurst(burst, offices, false); 
+    benchBurst(burst, offices, true); 
+    return EXIT_SUCCESS; 
+}
@@ -0,0 +1,175 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ *
+ * Program name:    benchWaitSlot.cpp
+
+ * Author:          María Espinosa Astilleros
+ *
+ * Date created:    17/10/2026
+ *
+ * Purpose:         Microbenchmark of the handoff of a turn to one of many waiting threads. It compares
+ *                  a condition variable shared by every waiter, woken with notify_all as the manager of
+ *                  the first version did, with a WaitSlot for each waiter, and counts the context switches
+ *
+ ******************************************************/
+
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <sys/resource.h>
+
+#include "../include/color.h"
+#include "../include/WaitSlot.h"
+
+#define DEFAULT_TURNS       20000
+
+typedef std::chrono::steady_clock Clock;
+
+/******************************************************
+ * Function name:    contextSwitches
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Voluntary and involuntary context switches of the process until now
+ *
+ ******************************************************/
+long contextSwitches(){
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+/******************************************************
+ * Function name:    showResult
+ * Date created:     17/10/2026
+ * Input arguments:  name of the test, waiters, turns, elapsed time and context switches
+ * Purpose:          Show the latency and the context switches of each turn
+ *
+ ******************************************************/
+void showResult(std::string name, int waiters, long turns, Clock::duration elapsed, long switches){
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << BOLDWHITE << "[BENCH] " << name << RESET << ": waiters=" << waiters << " turns=" << turns
+              << " us/turn=" << ns / turns / 1000.0 << " csw/turn=" << static_cast<double>(switches) / turns << std::endl;
+}
+
+/******************************************************
+ * Function name:    sharedCondition
+ * Date created:     17/10/2026
+ * Input arguments:  waiters and turns
+ * Purpose:          The dispatcher writes the id that has the turn and wakes every waiter,
+ *                   each one checks if the turn is its own and the rest sleep again
+ *
+ ******************************************************/
+void sharedCondition(int waiters, long turns){
+    std::mutex mutex_;
+    std::condition_variable cv_turn, cv_done;
+    int turn = 0;       /*0 nobody, -1 the waiters end*/
+    bool done = false;
+
+    std::vector<std::thread> threads;
+    for(int id = 1; id <= waiters; id++){
+        threads.push_back(std::thread([&, id](){
+            while(true){
+                std::unique_lock<std::mutex> ul(mutex_);
+                cv_turn.wait(ul, [&](){ return turn == id || turn == -1; });
+                if(turn == -1){
+                    return;
+                }
+                turn = 0;
+                done = true;
+                cv_done.notify_one();
+            }
+        }));
+    }
+
+    long switches = contextSwitches();
+    Clock::time_point start = Clock::now();
+    for(long i = 0; i < turns; i++){
+        std::unique_lock<std::mutex> ul(mutex_);
+        turn = 1 + i % waiters;
+        done = false;
+        cv_turn.notify_all();
+        cv_done.wait(ul, [&](){ return done; });
+    }
+    Clock::duration elapsed = Clock::now() - start;
+    switches = contextSwitches() - switches;
+    {
+        std::lock_guard<std::mutex> lg(mutex_);
+        turn = -1;
+    }
+    cv_turn.notify_all();
+    for(unsigned i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+    showResult("shared condition notify_all", waiters, turns, elapsed, switches);
+}
+
+/******************************************************
+ * Function name:    directHandoff
+ * Date created:     17/10/2026
+ * Input arguments:  waiters and turns
+ * Purpose:          The dispatcher signals the slot of the waiter that has the turn, nobody else wakes up
+ *
+ ******************************************************/
+void directHandoff(int waiters, long turns){
+    std::vector<std::unique_ptr<WaitSlot>> slots;
+    for(int id = 0; id < waiters; id++){
+        slots.push_back(std::unique_ptr<WaitSlot>(new WaitSlot(0)));
+    }
+    WaitSlot done(0);
+    bool stopping = false;
+
+    std::vector<std::thread> threads;
+    for(int id = 0; id < waiters; id++){
+        threads.push_back(std::thread([&, id](){
+            while(true){
+                slots[id]->wait();
+                if(stopping){
+                    return;
+                }
+                done.signal();
+            }
+        }));
+    }
+
+    long switches = contextSwitches();
+    Clock::time_point start = Clock::now();
+    for(long i = 0; i < turns; i++){
+        slots[i % waiters]->signal();
+        done.wait();
+    }
+    Clock::duration elapsed = Clock::now() - start;
+    switches = contextSwitches() - switches;
+    stopping = true;
+    for(int id = 0; id < waiters; id++){
+        slots[id]->signal();
+    }
+    for(unsigned i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+    showResult("direct handoff WaitSlot", waiters, turns, elapsed, switches);
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  [turns]
+ * Purpose:          Run both handoffs with more and more waiters
+ *
+ ******************************************************/
+int main(int argc, char *argv[]){
+    long turns = argc > 1 ? std::atol(argv[1]) : DEFAULT_TURNS;
+    int  waiters[] = {1, 4, 16, 64, 256};
+
+    for(int w : waiters){
+        sharedCondition(w, turns);
+        directHandoff(w, turns);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Clock.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the clocks that give the time and the service delays
+ * 
+ ******************************************************/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+/******************************************************
+ * Class name:       Clock
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Time of the simulation in microseconds. Every service delay goes through sleepFor(). 
+ *                   enter() and leave() mark when a thread starts and ends taking part in the simulation
+ * 
+ ******************************************************/
+class Clock{
+    public:
+        virtual ~Clock(){}
+        virtual long now() = 0; 
+        virtual void sleepFor(long us) = 0; 
+        virtual void enter(){}
+        virtual void leave(){}
+}; 
+
+/******************************************************
+ * Class name:       RealClock
+ * Date created:     17/10/2026
+ * Input arguments:  factor applied to the delays
+ * Purpose:          The delays are slept in real time multiplied by the scale. With scale 0 there are 
+ *                   no delays and the time doesn't advance
+ * 
+ ******************************************************/
+class RealClock: public Clock{
+    private:
+        double                                  scale; 
+        std::chrono::steady_clock::time_point   start; 
+
+    public:
+        RealClock(double scale); 
+        long now() override; 
+        void sleepFor(long us) override; 
+}; 
+
+/******************************************************
+ * Class name:       VirtualClock
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Discrete event clock. The threads run the same code but the delays don't sleep: the time 
+ *                   jumps to the next event when every thread of the simulation is sleeping or waiting. 
+ *                   For that the threads must wait through waitFor() on the address of what they wait for 
+ *                   and who changes it must call notify(). The thread that creates the clock is already in 
+ *                   the simulation and the events of the same time run in the order they were armed
+ * 
+ ******************************************************/
+class VirtualClock: public Clock{
+    private:
+        struct Sleeper{
+            bool                        done; 
+            std::condition_variable     cv; 
+        };
+        struct Event{
+            long                    time; 
+            long                    seq; 
+            Sleeper                *sleeper;    /*thread to wake or nullptr to run the function*/
+            std::function<void()>   fn; 
+        };
+        struct Later{
+            bool operator()(const Event &a, const Event &b) const { return a.time != b.time ? a.time > b.time : a.seq > b.seq; }
+        };
+        struct Channel{
+            long                        generation = 0; 
+            int                         waiters    = 0; 
+            std::condition_variable     cv; 
+        };
+
+        long                                            current; 
+        long                                            seq; 
+        int                                             active;     /*threads of the simulation that can run*/
+        long                                            num_events; 
+        std::priority_queue<Event, std::vector<Event>, Later> events; 
+        std::unordered_map<const void*, Channel>        channels; 
+        std::mutex                                      mutex_; 
+
+        void advance(std::unique_lock<std::mutex> &ul); 
+
+    public:
+        VirtualClock(); 
+        long now() override; 
+        void sleepFor(long us) override; 
+        void enter() override; 
+        void leave() override; 
+        void schedule(long us, std::function<void()> fn); 
+        long prepareWait(const void *key); 
+        void wait(const void *key, long ticket); 
+        void notify(const void *key); 
+        long getEvents(); 
+
+        /*Method waitFor. It waits until ready() is true, ready() is called again after each notify() of the key*/
+        template <typename F> 
+        void waitFor(const void *key, F ready){
+            while(true){
+                long ticket = prepareWait(key); 
+                if(ready()){
+                    return; 
+                }
+                wait(key, ticket); 
+            }
+        }
+}; 
+
+#endif
@@ -0,0 +1,305 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Coroutine.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the coroutines of the cinema and the executor that runs them.
+ *                  It is only compiled with C++20 in the coroutine mode (make coro)
+ * 
+ ******************************************************/
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+#include "ThreadPool.h"
+#include "Clock.h"
+
+/******************************************************
+ * Class name:       Task
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Coroutine that nobody waits for, a client or a service. It starts when the executor spawns it
+ *                   and its frame is freed when it ends
+ * 
+ ******************************************************/
+struct Task{
+    struct promise_type{
+        Task                get_return_object(){ return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void(){}
+        void                unhandled_exception(){ std::terminate(); }
+    }; 
+    std::coroutine_handle<promise_type> handle; 
+}; 
+
+/******************************************************
+ * Class name:       Async
+ * Date created:     17/10/2026
+ * Input arguments:  type of the result
+ * Purpose:          Coroutine that another one waits for with co_await. It starts when it is awaited and
+ *                   at the end it goes on with the caller in the same worker
+ * 
+ ******************************************************/
+template <typename T>
+class Async{
+    public:
+        struct Final{
+            bool                    await_ready() noexcept { return false; }
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept { return h.promise().caller; }
+            void                    await_resume() noexcept {}
+        }; 
+        struct PromiseBase{
+            std::coroutine_handle<> caller; 
+            std::suspend_always     initial_suspend() noexcept { return {}; }
+            Final                   final_suspend() noexcept { return {}; }
+            void                    unhandled_exception(){ std::terminate(); }
+        }; 
+        struct PromiseValue: PromiseBase{
+            T       value; 
+            void    return_value(T v){ value = std::move(v); }
+            T       result(){ return std::move(value); }
+        }; 
+        struct PromiseVoid: PromiseBase{
+            void    return_void(){}
+            void    result(){}
+        }; 
+        struct promise_type: std::conditional_t<std::is_void_v<T>, PromiseVoid, PromiseValue>{
+            Async get_return_object(){ return Async(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        }; 
+
+        Async(Async &&other): handle(std::exchange(other.handle, nullptr)){}
+        ~Async(){
+            if(handle){
+                handle.destroy(); 
+            }
+        }
+        bool                    await_ready(){ return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller){
+            handle.promise().caller = caller; 
+            return handle; 
+        }
+        T                       await_resume(){ return handle.promise().result(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle; 
+
+        explicit Async(std::coroutine_handle<promise_type> h): handle(h){}
+}; 
+
+/******************************************************
+ * Class name:       Executor
+ * Date created:     17/10/2026
+ * Input arguments:  pool of workers, clock and scale of the delays in real time
+ * Purpose:          It runs the coroutines in the workers of the pool. A suspended coroutine doesn't use a thread,
+ *                   it is resumed by who gives it what it waits for. In virtual time a resumed coroutine takes
+ *                   part in the simulation until it suspends again, and the delays are events of the clock.
+ *                   In real time a timer thread resumes the coroutines at the end of their delays
+ * 
+ ******************************************************/
+class Executor{
+    private:
+        struct Timer{
+            long                    deadline;   /*us of the steady clock*/
+            long                    seq; 
+            std::coroutine_handle<> handle; 
+        }; 
+        struct Later{
+            bool operator()(const Timer &a, const Timer &b) const { return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq; }
+        }; 
+
+        ThreadPool                                          &pool; 
+        Clock                                               *clock; 
+        VirtualClock                                        *virtual_clock; 
+        double                                               scale; 
+        std::priority_queue<Timer, std::vector<Timer>, Later> timers; 
+        long                                                 seq; 
+        std::mutex                                           mutex_; 
+        std::condition_variable                              cv_; 
+        bool                                                 stopping; 
+        std::thread                                          timer; 
+
+        static Executor                                     *current; 
+
+        void runTimers(); 
+
+    public:
+        struct Sleep{
+            Executor   *executor; 
+            long        us; 
+            bool        await_ready(){ return us <= 0 || (executor->virtual_clock == nullptr && executor->scale <= 0); }
+            void        await_suspend(std::coroutine_handle<> h){ executor->wakeAfter(us, h); }
+            void        await_resume(){}
+        }; 
+
+        Executor(ThreadPool &pool, Clock *clock, VirtualClock *virtual_clock, double scale); 
+        ~Executor(); 
+        void  spawn(Task task); 
+        void  resume(std::coroutine_handle<> h); 
+        void  wakeAfter(long us, std::coroutine_handle<> h); 
+        Sleep sleepFor(long us); 
+        void  stop(); 
+
+        static Executor *get(); 
+}; 
+
+/******************************************************
+ * Class name:       Handoff
+ * Date created:     17/10/2026
+ * Input arguments:  callback of the request and function that sends it
+ * Purpose:          co_await Handoff{msg.on_attended, send} sends a request to a service and suspends the coroutine
+ *                   until the service calls the callback of the request
+ * 
+ ******************************************************/
+struct Handoff{
+    std::function<void()>  &callback; 
+    std::function<void()>   send; 
+
+    bool await_ready(){ return false; }
+    void await_suspend(std::coroutine_handle<> h){
+        std::function<void()> run = std::move(send);   /*the coroutine can be resumed and this awaiter gone before run returns*/
+        callback = [h](){ Executor::get()->resume(h); }; 
+        run(); 
+    }
+    void await_resume(){}
+}; 
+
+/******************************************************
+ * Class name:       AsyncQueue
+ * Date created:     17/10/2026
+ * Input arguments:  capacity (it isn't bounded, it keeps the interface of MpmcQueue)
+ * Purpose:          Queue of messages for coroutines. pop() suspends the coroutine when the queue is empty and
+ *                   push() gives the message straight to the first coroutine waiting, so a waiting service
+ *                   costs only its place in the list. The messages take memory only while they are queued
+ * 
+ ******************************************************/
+template <typename T>
+class AsyncQueue{
+    private:
+        struct Waiter{
+            std::coroutine_handle<>  handle; 
+            T                       *slot; 
+        }; 
+        std::deque<T>       items; 
+        std::deque<Waiter>  waiters; 
+        std::mutex          mutex_; 
+
+    public:
+        struct Pop{
+            AsyncQueue *queue; 
+            T           value; 
+            bool        await_ready(){ return false; }
+            bool        await_suspend(std::coroutine_handle<> h){
+                std::lock_guard<std::mutex> lg(queue->mutex_); 
+                if(!queue->items.empty()){
+                    value = queue->items.front(); 
+                    queue->items.pop_front(); 
+                    return false; 
+                }
+                queue->waiters.push_back({h, &value}); 
+                return true; 
+            }
+            T           await_resume(){ return value; }
+        }; 
+
+        AsyncQueue(int capacity = 0){}
+
+        /*Method push. The message goes to the first coroutine waiting or to the queue*/
+        void push(T msg){
+            std::unique_lock<std::mutex> ul(mutex_); 
+            if(waiters.empty()){
+                items.push_back(msg); 
+                return; 
+            }
+            Waiter waiter = waiters.front(); 
+            waiters.pop_front(); 
+            *waiter.slot = msg; 
+            ul.unlock(); 
+            Executor::get()->resume(waiter.handle); 
+        }
+
+        /*Method try_pop. A message if there is one, for the sale points that steal clients*/
+        bool try_pop(T &msg){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            if(items.empty()){
+                return false; 
+            }
+            msg = items.front(); 
+            items.pop_front(); 
+            return true; 
+        }
+
+        /*Method pop. co_await queue.pop() gives the next message*/
+        Pop pop(){ return Pop{this, T()}; }
+
+        /*Method size*/
+        long size(){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return items.size(); 
+        }
+}; 
+
+/******************************************************
+ * Class name:       AsyncSemaphore
+ * Date created:     17/10/2026
+ * Input arguments:  initial count
+ * Purpose:          Counting semaphore for coroutines, the same as SemCounter but wait() suspends the coroutine
+ * 
+ ******************************************************/
+class AsyncSemaphore{
+    private:
+        long                                count; 
+        std::deque<std::coroutine_handle<>> waiters; 
+        std::mutex                          mutex_; 
+
+    public:
+        struct Wait{
+            AsyncSemaphore *sem; 
+            bool            await_ready(){ return false; }
+            bool            await_suspend(std::coroutine_handle<> h){
+                std::lock_guard<std::mutex> lg(sem->mutex_); 
+                if(sem->count > 0){
+                    sem->count--; 
+                    return false; 
+                }
+                sem->waiters.push_back(h); 
+                return true; 
+            }
+            void            await_resume(){}
+        }; 
+
+        AsyncSemaphore(long count): count(count){}
+
+        /*Method signal. It resumes the first coroutine waiting or counts the signal*/
+        void signal(){
+            std::unique_lock<std::mutex> ul(mutex_); 
+            if(waiters.empty()){
+                count++; 
+                return; 
+            }
+            std::coroutine_handle<> h = waiters.front(); 
+            waiters.pop_front(); 
+            ul.unlock(); 
+            Executor::get()->resume(h); 
+        }
+
+        /*Method wait. co_await sem.wait()*/
+        Wait wait(){ return Wait{this}; }
+}; 
+
+#endif
@@ -0,0 +1,220 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    FairScheduler.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the weighted fair scheduler between classes of requests
+ * 
+ ******************************************************/
+#ifndef FAIRSCHEDULER_H
+#define FAIRSCHEDULER_H
+
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+
+#include "Clock.h"
+
+#define STRIDE_BASE     (1L << 20)
+#define WAIT_BUCKETS    40      /*bucket i counts the waits of i bits, the last one up to 2^39 microseconds*/
+
+/******************************************************
+ * Class name:       FairScheduler
+ * Date created:     17/10/2026
+ * Input arguments:  weight of each class, starvation bound in microseconds and clock of the times (nullptr is real time)
+ * Purpose:          Stride scheduling. Each class advances its pass by STRIDE_BASE / weight every time it 
+ *                   is served and pop() serves the waiting class with the lowest pass, so a class of weight 4 
+ *                   is served 4 times for each time of a class of weight 1. A class that was empty starts at the 
+ *                   current pass so it can't save turns. If the first request of a class has waited more than the 
+ *                   starvation bound it is served before anything else. 
+ *                   The waits of the requests served go to a histogram of each class with a bucket for each power 
+ *                   of two, as in Metrics, and the percentiles are taken from its buckets
+ * 
+ ******************************************************/
+template <typename T>
+class FairScheduler{
+    private:
+        struct Entry{
+            T       item; 
+            long    arrival;    /*microseconds*/
+        };
+
+        std::vector<std::deque<Entry>>  queues; 
+        std::vector<long>               strides; 
+        std::vector<long>               passes; 
+        std::vector<std::vector<long>>  waits;          /*requests served of each class in each bucket of the wait*/
+        std::vector<long>               served; 
+        std::vector<long>               max_wait;       /*microseconds*/
+        long                            global_pass; 
+        long                            starvation_us; 
+        long                            num_starved; 
+        bool                            closed; 
+        Clock                          *clock; 
+        std::mutex                      mutex_; 
+        std::condition_variable         cv_; 
+
+        /*Current time in microseconds*/
+        long timeNow(){
+            if(clock != nullptr){
+                return clock->now(); 
+            }
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); 
+        }
+
+        /*It takes the next request to serve with the mutex locked, false if there isn't any*/
+        bool take(T &item){
+            for(unsigned c = 0; c < queues.size(); c++){
+                if(!queues[c].empty()){
+                    long now    = timeNow(); 
+                    int chosen  = choose(now); 
+                    Entry entry = queues[chosen].front(); 
+                    queues[chosen].pop_front(); 
+                    global_pass      = passes[chosen]; 
+                    passes[chosen]  += strides[chosen]; 
+                    record(chosen, now - entry.arrival); 
+                    item = entry.item; 
+                    return true; 
+                }
+            }
+            return false; 
+        }
+
+        /*It counts the wait of a request served in the bucket of its number of bits*/
+        void record(int cls, long wait){
+            if(wait < 0){
+                wait = 0; 
+            }
+            int bucket = wait == 0 ? 0 : 64 - __builtin_clzl(wait); 
+            if(bucket >= WAIT_BUCKETS){
+                bucket = WAIT_BUCKETS - 1; 
+            }
+            waits[cls][bucket]++; 
+            served[cls]++; 
+            max_wait[cls] = std::max(max_wait[cls], wait); 
+        }
+
+        /*It chooses the class to serve, there is at least one waiting*/
+        int choose(long now){
+            int chosen = -1; 
+            for(unsigned c = 0; c < queues.size(); c++){
+                if(!queues[c].empty() && now - queues[c].front().arrival > starvation_us && 
+                   (chosen < 0 || queues[c].front().arrival < queues[chosen].front().arrival)){
+                    chosen = c; 
+                }
+            }
+            if(chosen >= 0){
+                num_starved++; 
+                return chosen; 
+            }
+            for(unsigned c = 0; c < queues.size(); c++){
+                if(!queues[c].empty() && (chosen < 0 || passes[c] < passes[chosen])){
+                    chosen = c; 
+                }
+            }
+            return chosen; 
+        }
+
+    public:
+        FairScheduler(const std::vector<int> &weights, long starvation, Clock *c = nullptr): 
+            queues(weights.size()), passes(weights.size(), 0), waits(weights.size(), std::vector<long>(WAIT_BUCKETS, 0)), 
+            served(weights.size(), 0), max_wait(weights.size(), 0), global_pass(0), starvation_us(starvation), num_starved(0), closed(false), clock(c){
+            for(unsigned c = 0; c < weights.size(); c++){
+                strides.push_back(STRIDE_BASE / (weights[c] > 0 ? weights[c] : 1)); 
+            }
+        }
+
+        /*Method push*/
+        void push(int cls, const T &item){
+            {
+                std::lock_guard<std::mutex> lg(mutex_); 
+                if(queues[cls].empty()){
+                    passes[cls] = std::max(passes[cls], global_pass); 
+                }
+                Entry entry = {item, timeNow()}; 
+                queues[cls].push_back(entry); 
+            }
+            cv_.notify_one(); 
+        }
+
+        /*Method pop. It blocks until there is a request, false if the scheduler is closed and empty*/
+        bool pop(T &item){
+            std::unique_lock<std::mutex> ul(mutex_); 
+            while(!take(item)){
+                if(closed){
+                    return false; 
+                }
+                cv_.wait(ul); 
+            }
+            return true; 
+        }
+
+        /*Method try_pop. False if there isn't any request*/
+        bool try_pop(T &item){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return take(item); 
+        }
+
+        /*Method isClosed*/
+        bool isClosed(){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return closed; 
+        }
+
+        /*Method close. pop() returns false when the requests left are served*/
+        void close(){
+            {
+                std::lock_guard<std::mutex> lg(mutex_); 
+                closed = true; 
+            }
+            cv_.notify_all(); 
+        }
+
+        /*Method getWaitPercentile. Wait in microseconds of the percentile p (0-100) of the class, interpolated 
+          inside its bucket and never above the longest wait*/
+        long getWaitPercentile(int cls, double p){
+            long counts[WAIT_BUCKETS]; 
+            long total, longest; 
+            {
+                std::lock_guard<std::mutex> lg(mutex_); 
+                std::copy(waits[cls].begin(), waits[cls].end(), counts); 
+                total   = served[cls]; 
+                longest = max_wait[cls]; 
+            }
+            if(total == 0){
+                return 0; 
+            }
+            long index  = static_cast<long>(p / 100.0 * (total - 1)); 
+            long before = 0; 
+            for(int b = 0; b < WAIT_BUCKETS; b++){
+                if(before + counts[b] > index){
+                    long low  = b == 0 ? 0 : 1L << (b - 1); 
+                    long high = b == 0 ? 0 : (1L << b) - 1; 
+                    long wait = low + static_cast<long>((high - low) * ((index - before) + 0.5) / counts[b]); 
+                    return std::min(wait, longest); 
+                }
+                before += counts[b]; 
+            }
+            return longest; 
+        }
+
+        /*Method getServed*/
+        long getServed(int cls){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return served[cls]; 
+        }
+
+        /*Method getStarved. Requests served because they reached the starvation bound*/
+        long getStarved(){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return num_starved; 
+        }
+}; 
+
+#endif
@@ -0,0 +1,102 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Inventory.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the inventory of seats of every showing
+ * 
+ ******************************************************/
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <vector>
+#include <mutex>
+#include <string>
+#include <atomic>
+
+#include "SeatMap.h"
+
+/******************************************************
+ * Class name:       Showing
+ * Date created:     17/10/2026
+ * Input arguments:  id, hall and size of the hall
+ * Purpose:          Seats of one showing with its own lock. It is aligned to a cache line 
+ *                   so the locks of two showings never share it. available is the number of seats that 
+ *                   nobody has taken: a sale takes its seats from it with a compare and swap before it locks 
+ *                   the map to choose them, so it can never take more than the free ones and a sale that 
+ *                   doesn't fit is refused without the lock. sold only grows when a sale is confirmed, so the 
+ *                   seats that may still be sold, free or held, can be read at once without the lock
+ * 
+ ******************************************************/
+class alignas(64) Showing{
+    public:
+        int         id;
+        int         hall;
+        SeatMap     seats;
+        int         held;           /*seats taken by a hold that isn't confirmed yet*/
+        std::atomic<int> available; /*free seats that no sale has taken, it is never below 0*/
+        std::atomic<int> sold;      /*seats sold and confirmed*/
+        std::mutex  mutex_; 
+
+        Showing(int id, int hall, int rows, int cols); 
+};
+
+/******************************************************
+ * Struct name:      BookingLeg
+ * Date created:     17/10/2026
+ * Purpose:          Seats of one showing of a group order, the inventory fills the seats
+ * 
+ ******************************************************/
+struct BookingLeg{
+    int                 showing; 
+    int                 num_seats; 
+    std::vector<int>    seats; 
+}; 
+
+/******************************************************
+ * Class name:       Inventory
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Showings of every hall indexed by their id (from 1). The showings are added 
+ *                   before the sales start, after that the lookup is without lock and each sale 
+ *                   only locks its own showing, so sales of different showings don't wait each other. 
+ *                   A group order locks the showings of all its legs, always in increasing id so two orders 
+ *                   can't wait for each other, and takes every leg or none while it has them
+ * 
+ ******************************************************/
+class Inventory{
+    private:
+        std::vector<Showing*>   showings; 
+
+        Showing *get(int showing); 
+        bool     take(Showing *s, int n); 
+        void     lockGroup(const std::vector<BookingLeg> &legs, std::vector<std::unique_lock<std::mutex>> &locks); 
+
+    public:
+        ~Inventory(); 
+        int  addShowing(int hall, int rows, int cols); 
+        bool allocate(int showing, int n, std::vector<int> &seats); 
+        void release(int showing, const std::vector<int> &seats); 
+        bool hold(int showing, int n, std::vector<int> &seats); 
+        void confirm(int showing, const std::vector<int> &seats); 
+        void releaseHold(int showing, const std::vector<int> &seats); 
+        bool restore(int showing, int seat); 
+        bool holdGroup(std::vector<BookingLeg> &legs); 
+        void confirmGroup(const std::vector<BookingLeg> &legs); 
+        void releaseGroupHold(const std::vector<BookingLeg> &legs); 
+        int  getHeld(int showing); 
+        int  getFree(int showing); 
+        int  getAvailable(int showing); 
+        int  getRemaining(int showing); 
+        int  getCapacity(int showing); 
+        int  getHall(int showing); 
+        int  getNumShowings(); 
+        int  getSold(); 
+        std::string seatName(int showing, int seat); 
+}; 
+
+#endif
@@ -0,0 +1,142 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Journal.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the journal of the sales
+ * 
+ ******************************************************/
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+#define JOURNAL_ASYNC       0       /*the commit doesn't wait, the flusher syncs the records in the background*/
+#define JOURNAL_GROUP       1       /*the commit waits for the flusher, one sync for every commit that arrived meanwhile*/
+#define JOURNAL_SYNC        2       /*each commit syncs its own records*/
+
+#define J_SEAT_SOLD         1       /*showing, seat*/
+#define J_STOCK             2       /*sale point, drinks and popcorn added (negative if taken)*/
+#define J_PAYMENT           3       /*client, type, result*/
+
+/*Result of a payment*/
+#define J_PAY_REJECTED      0
+#define J_PAY_APPROVED      1
+#define J_PAY_REFUNDED      2       /*approved after its hold expired, the seats were free again and the money is given back*/
+
+#define JOURNAL_MAGIC       "CINEJRN1"
+#define SNAPSHOT_MAGIC      "CINESNP2"
+#define JOURNAL_HEADER      4096                /*bytes before the first record, a page so the records are aligned*/
+#define JOURNAL_CHUNK       (64L << 20)         /*the file grows 64 MB each time*/
+#define JOURNAL_MAX_SIZE    (64L << 30)         /*size of the mapping, the file is never bigger*/
+
+/******************************************************
+ * Struct name:      JournalRecord
+ * Date created:     17/10/2026
+ * Purpose:          Change of the state. The records of a transaction are written together, left counts
+ *                   the ones after this one, and the recovery only applies a transaction if all of them are valid
+ * 
+ ******************************************************/
+struct JournalRecord{
+    unsigned long   lsn;        /*sequence number, the first record is 1*/
+    int             type; 
+    int             left; 
+    int             args[3]; 
+    unsigned        checksum;   /*of the bytes before it, a torn or empty record doesn't match*/
+}; 
+
+/******************************************************
+ * Struct name:      JournalState
+ * Date created:     17/10/2026
+ * Purpose:          State rebuilt from the journal: the seats sold of each showing, the stock of each
+ *                   sale point and the payments. The vectors grow with the showings and sale points of the records
+ * 
+ ******************************************************/
+struct JournalState{
+    unsigned long                   lsn;            /*last record applied*/
+    std::vector<std::vector<char>>  seats;          /*seats[showing - 1][seat] is 1 if it is sold*/
+    std::vector<long>               drinks;         /*drinks[sale point - 1]*/
+    std::vector<long>               popcorn; 
+    long                            approved; 
+    long                            rejected; 
+    long                            refunded; 
+
+    JournalState(); 
+    void apply(const JournalRecord &record); 
+    long getSold(); 
+}; 
+
+/******************************************************
+ * Class name:       Journal
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Append-only journal mapped in memory. A commit copies its records at the end of the file
+ *                   under a short lock and, in group mode, waits until the flusher syncs them, so the
+ *                   commits that arrive during one sync share the next one. A commit with a function doesn't
+ *                   wait, the flusher calls it after the sync. The flusher also writes a snapshot
+ *                   of the state every few records and the recovery replays only the records after it.
+ *                   Until open is called the commits do nothing
+ * 
+ ******************************************************/
+class Journal{
+    private:
+        std::string                 file; 
+        int                         fd; 
+        char                       *base;           /*mapping of JOURNAL_MAX_SIZE bytes, the file is shorter*/
+        long                        size;           /*bytes of the file*/
+        long                        page; 
+        int                         durability; 
+        long                        window_us;      /*time the flusher waits for more commits before a sync*/
+        long                        snapshot_every; /*records between two snapshots, 0 never*/
+
+        unsigned long               written;        /*lsn of the last record copied*/
+        unsigned long               durable;        /*lsn of the last record synced*/
+        std::vector<std::pair<unsigned long, std::function<void()>>> waiting;   /*last lsn of each commit that doesn't wait and its function*/
+        JournalState                snapshot;       /*state at the last snapshot*/
+        std::atomic<long>           commits; 
+        std::atomic<long>           syncs; 
+        std::atomic<long>           snapshots; 
+
+        std::mutex                  mutex_; 
+        std::condition_variable     work_;          /*wakes the flusher*/
+        std::condition_variable     done_;          /*wakes the commits when the records are synced*/
+        bool                        stopping; 
+        std::thread                 flusher; 
+
+        long offset(unsigned long lsn); 
+        unsigned long append(JournalRecord *records, int n, std::function<void()> *on_durable); 
+        void sync(unsigned long from, unsigned long to); 
+        void flush(); 
+        void writeSnapshot(unsigned long lsn); 
+        static unsigned checksum(const JournalRecord &record); 
+        static bool readSnapshot(std::string file, JournalState &state); 
+        static unsigned long replay(const char *records, long bytes, JournalState &state); 
+
+    public:
+        Journal(); 
+        ~Journal(); 
+        bool          open(std::string file, int durability, long window_us, long snapshot_every, JournalState &state); 
+        unsigned long commit(JournalRecord *records, int n); 
+        void          commit(JournalRecord *records, int n, std::function<void()> on_durable); 
+        void          close(); 
+        void          syncFile(); 
+        bool          isOpen(); 
+        long          getCommits(); 
+        long          getSyncs(); 
+        long          getSnapshots(); 
+        unsigned long getRecords(); 
+
+        static bool   recover(std::string file, JournalState &state); 
+}; 
+
+#endif
@@ -0,0 +1,46 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    LatencyStats.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the latencies of a phase of the simulation
+ * 
+ ******************************************************/
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <atomic>
+#include <string>
+
+#define LATENCY_BUCKETS     40      /*bucket i counts the latencies of i bits, the last one up to 2^39 microseconds*/
+
+/******************************************************
+ * Class name:       LatencyStats
+ * Date created:     17/10/2026
+ * Input arguments:  name of the phase
+ * Purpose:          It counts the latency in microseconds of every request that goes through a phase in a 
+ *                   histogram with a bucket for each power of two, as Metrics does, so record() is an atomic add 
+ *                   without a lock and the memory doesn't grow with the run. The percentiles are interpolated 
+ *                   inside their bucket at the end of the run
+ * 
+ ******************************************************/
+class LatencyStats{
+    private:
+        std::string         name; 
+        std::atomic<long>   buckets[LATENCY_BUCKETS]; 
+        std::atomic<long>   max_us; 
+
+    public:
+        LatencyStats(std::string name); 
+        void        record(long us); 
+        std::string getName(); 
+        long        getCount(); 
+        long        getPercentile(double p); 
+        long        getMax(); 
+}; 
+
+#endif
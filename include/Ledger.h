@@ -0,0 +1,148 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Ledger.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the ledger of the sales and its queries
+ * 
+ ******************************************************/
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <climits>
+#include <condition_variable>
+
+#include "PerThread.h"
+
+#define LEDGER_CHUNK_ROWS   65536   /*rows of each chunk, power of two*/
+#define LEDGER_MAX_CHUNKS   32768   /*chunks of the directory, 2^31 rows*/
+#define LEDGER_RING_SIZE    8192    /*rows of the ring of each thread, power of two*/
+#define LEDGER_BATCH        1024    /*rows of each step of a scan*/
+#define LEDGER_FLUSH_MS     5       /*ms between two passes of the writer*/
+
+/*Columns of a group by*/
+#define LEDGER_SALE_POINT   0
+#define LEDGER_MINUTE       1
+#define LEDGER_SHOWING      2
+#define LEDGER_BASKET       3
+#define LEDGER_KEYS         4
+#define LEDGER_TOTAL        4       /*a single group with every row*/
+
+/******************************************************
+ * Struct name:      LedgerRow
+ * Date created:     17/10/2026
+ * Purpose:          Sale of a completed payment as it is appended
+ * 
+ ******************************************************/
+struct LedgerRow{
+    unsigned        time;       /*second of the sale*/
+    int             amount;     /*cents*/
+    unsigned short  point;      /*sale point, 0 the ticket offices*/
+    unsigned short  showing;    /*0 if it isn't a ticket*/
+    unsigned char   basket;     /*seats or drinks and popcorn bought*/
+    unsigned char   type;       /*type of the payment*/
+}; 
+
+/******************************************************
+ * Struct name:      LedgerFilter
+ * Date created:     17/10/2026
+ * Purpose:          Rows of a query: a type of payment (0 every type) and the seconds [from, to)
+ * 
+ ******************************************************/
+struct LedgerFilter{
+    int         type = 0; 
+    unsigned    from = 0; 
+    unsigned    to   = UINT_MAX; 
+}; 
+
+/******************************************************
+ * Struct name:      LedgerGroup
+ * Date created:     17/10/2026
+ * Purpose:          Result of a group of a query
+ * 
+ ******************************************************/
+struct LedgerGroup{
+    long    key; 
+    long    rows; 
+    long    revenue;    /*cents*/
+}; 
+
+/******************************************************
+ * Class name:       Ledger
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Append-only ledger of the sales kept in memory by columns. A sale is written in the ring of
+ *                   its thread, with one producer and one consumer, so the thread never takes a lock; only if
+ *                   its ring is full it moves the rows itself. A background writer moves the rows every few
+ *                   milliseconds to the chunks of the columns and then publishes how many there are.
+ *                   The queries read only the published rows, the chunks are never moved nor changed after
+ *                   that, so they run without locks while the sales go on. They scan the columns they need in
+ *                   steps of LEDGER_BATCH rows: first the selection of the filter and the key of each row, loops
+ *                   the compiler vectorizes, then the sums. A chunk that is full keeps its first and last second
+ *                   so a query of a range of time skips the chunks out of it
+ * 
+ ******************************************************/
+class Ledger{
+    private:
+        struct Chunk{
+            unsigned        time[LEDGER_CHUNK_ROWS]; 
+            int             amount[LEDGER_CHUNK_ROWS]; 
+            unsigned short  point[LEDGER_CHUNK_ROWS]; 
+            unsigned short  showing[LEDGER_CHUNK_ROWS]; 
+            unsigned char   basket[LEDGER_CHUNK_ROWS]; 
+            unsigned char   type[LEDGER_CHUNK_ROWS]; 
+            unsigned        min_time;   /*read only when the chunk is full*/
+            unsigned        max_time; 
+        }; 
+
+        struct alignas(64) Ring{
+            LedgerRow                               rows[LEDGER_RING_SIZE]; 
+            alignas(64) std::atomic<unsigned long>  head;   /*written by the writer*/
+            alignas(64) std::atomic<unsigned long>  tail;   /*written by the thread of the ring*/
+
+            Ring(); 
+        }; 
+
+        std::atomic<Chunk*>        *chunks; 
+        std::atomic<long>           published;              /*rows the queries can read*/
+        std::atomic<long>           max_key[LEDGER_KEYS];   /*largest key of each column, written before the rows are published*/
+        long                        stored;                 /*rows in the chunks, only the one that moves them uses it*/
+        long                        dropped;                /*rows that don't fit in the directory*/
+
+        std::vector<Ring*>          rings; 
+        PerThread<Ring>             locals;                 /*ring of each thread*/
+        std::mutex                  mutex_;                 /*rings and writer*/
+        std::mutex                  mutex_move;             /*only one moves the rows to the chunks*/
+        std::condition_variable     cv_; 
+        bool                        stopping; 
+        std::thread                 writer; 
+
+        Ring *ring(); 
+        void  store(const LedgerRow &row); 
+        void  write(); 
+        void  scan(int column, const LedgerFilter &filter, long n, long keys, long *rows, long *revenue); 
+
+    public:
+        Ledger(); 
+        ~Ledger(); 
+        void append(unsigned time, int type, int point, int showing, int basket, int amount); 
+        void flush(); 
+        void start(); 
+        void stop(); 
+
+        long                     revenue(const LedgerFilter &filter = LedgerFilter()); 
+        std::vector<LedgerGroup> groupBy(int column, const LedgerFilter &filter = LedgerFilter()); 
+        long                     getRows(); 
+        long                     getDropped(); 
+        long                     getBytes(); 
+}; 
+
+#endif
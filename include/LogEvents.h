@@ -0,0 +1,114 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    LogEvents.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the lines that the cinema logs. The cinema and logdump share the table
+ *                  so the binary logs can be formatted offline
+ * 
+ ******************************************************/
+#ifndef LOGEVENTS_H
+#define LOGEVENTS_H
+
+#include "color.h"
+#include "Logger.h"
+
+enum{
+    EV_CLIENT_CREATED,
+    EV_CLIENT_TURN,
+    EV_CLIENT_WANTS_TICKETS,
+    EV_CLIENT_HAS_TICKETS,
+    EV_CLIENT_NO_TICKETS,
+    EV_CLIENT_SOLD_OUT,
+    EV_CLIENT_WAITLISTED,
+    EV_CLIENT_PROMOTED,
+    EV_CLIENT_WANTS_FOOD,
+    EV_CLIENT_HAS_FOOD,
+    EV_CLIENT_TO_MOVIE,
+    EV_CLIENT_ERROR,
+    EV_TICKET_OFFICE_OPEN,
+    EV_TICKET_OFFICE_HELD,
+    EV_TICKET_OFFICE_PAYMENT,
+    EV_TICKET_OFFICE_REFUSED,
+    EV_TICKET_OFFICE_LEFT,
+    EV_TICKET_OFFICE_EXPIRED,
+    EV_TICKET_OFFICE_REJECTED,
+    EV_TICKET_OFFICE_ATTENDED,
+    EV_TICKET_OFFICE_ERROR,
+    EV_SALE_POINT_CREATED,
+    EV_SALE_POINT_REQUEST,
+    EV_SALE_POINT_LEFT,
+    EV_SALE_POINT_REFUSED,
+    EV_SALE_POINT_STALL,
+    EV_SALE_POINT_REPLENISH,
+    EV_SALE_POINT_PAYMENT,
+    EV_SALE_POINT_REJECTED,
+    EV_SALE_POINT_ATTENDED,
+    EV_SALE_POINT_ERROR,
+    EV_REPLENISHER_CREATED,
+    EV_REPLENISHER_REQUEST,
+    EV_REPLENISHER_DONE,
+    EV_REPLENISHER_ERROR,
+    EV_PAYMENT_OPEN,
+    EV_PAYMENT_TICKETS,
+    EV_PAYMENT_FOOD,
+    EV_PAYMENT_REJECTED,
+    EV_MANAGER_READY,
+    EV_MANAGER_TICKETS_TURN,
+    EV_MANAGER_FOOD_TURN,
+    EV_MANAGER_ERROR,
+    NUM_LOG_EVENTS
+}; 
+
+/*Same order as the enum*/
+static const LogEvent g_log_events[NUM_LOG_EVENTS] = {
+    {YELLOW,    "[CLIENT {}] Created and waiting to buy tickets..."},
+    {YELLOW,    "[CLIENT {}] It's my turn for buy tickets!"},
+    {YELLOW,    "[CLIENT {}] I want {} tickets for showing {}"},
+    {YELLOW,    "[CLIENT {}] I have the tickets already ({s}). I go to buy drinks and popcorn..."},
+    {YELLOW,    "[CLIENT {}] No tickets left so I go to my house :("},
+    {YELLOW,    "[CLIENT {}] The showing {} has no seats for me, I go home without queueing"},
+    {YELLOW,    "[CLIENT {}] The showing {} has no seats now, I wait in its waitlist"},
+    {YELLOW,    "[CLIENT {}] Seats have been released, I leave the waitlist to buy tickets"},
+    {YELLOW,    "[CLIENT {}] I want {} drinks and {} popcorn"},
+    {YELLOW,    "[CLIENT {}] I have received drinks and popcorn"},
+    {YELLOW,    "[CLIENT {}] I have everything already. I go to see Harry Potter now! :)"},
+    {YELLOW,    "[CLIENT {}] An error occurred, the session has ended with a request still in a service..."},
+    {GREEN,     "[TICKET OFFICE {}] Ticket office open"},
+    {GREEN,     "[TICKET OFFICE {}] The client {} has requested {} tickets, {s} held"},
+    {GREEN,     "[TICKET OFFICE {}] I request the client's payment"},
+    {GREEN,     "[TICKET OFFICE {}] The client {} has requested more tickets than there are left"},
+    {GREEN,     "[TICKET OFFICE {}] {} tickets left"},
+    {GREEN,     "[TICKET OFFICE {}] The hold of the client {} has expired before the payment"},
+    {GREEN,     "[TICKET OFFICE {}] The payment of the client {} has been rejected"},
+    {GREEN,     "[TICKET OFFICE {}] The client {} has been attended"},
+    {GREEN,     "[TICKET OFFICE {}] An error occurred while attending clients..."},
+    {MAGENTA,   "[SALE POINT {}] Created with {} drinks and {} popcorn"},
+    {MAGENTA,   "[SALE POINT {}] The client {} has requested {} drinks and {} popcorn"},
+    {MAGENTA,   "[SALE POINT {}] {} drinks and {} popcorn left"},
+    {MAGENTA,   "[SALE POINT {}] The client {} has requested more drinks and popcorn than a sale point can have"},
+    {MAGENTA,   "[SALE POINT {}] The client {} has requested more drinks and popcorn than there are left, it waits for the stockers"},
+    {MAGENTA,   "[SALE POINT {}] I need replenish drinks and popcorn"},
+    {MAGENTA,   "[SALE POINT {}] I request the client's payment"},
+    {MAGENTA,   "[SALE POINT {}] The payment of the client {} has been rejected"},
+    {MAGENTA,   "[SALE POINT {}] Client {} has been attended"},
+    {MAGENTA,   "[SALE POINT {}] An error occurred while attending clients..."},
+    {RED,       "[REPLENISHER {}] Created and waiting to receive requests"},
+    {RED,       "[REPLENISHER {}] I have received a request to replenish the sale point {}"},
+    {RED,       "[REPLENISHER {}] I have replenished {} drinks and {} popcorn in sale point {}"},
+    {RED,       "[REPLENISHER] An error ocurred while replenishing the sale points"},
+    {BLUE,      "[PAYMENT SYSTEM] Payment system open with {} payments in flight and {} payments of tickets for each one of food"},
+    {BLUE,      "[PAYMENT SYSTEM] Payment request received. The client {} has paid tickets"},
+    {BLUE,      "[PAYMENT SYSTEM] Payment request received. The client {} has paid drinks and popcorn"},
+    {BLUE,      "[PAYMENT SYSTEM] Payment request rejected. The client {} hasn't paid"},
+    {CYAN,      "[MANAGER] Manager is ready"},
+    {CYAN,      "[MANAGER] It's the turn of client {} to buy tickets"},
+    {CYAN,      "[MANAGER] It's the turn of client {} to buy drinks and popcorn"},
+    {BOLDCYAN,  "[MANAGER] An error occurred while generating turns..."}
+}; 
+
+#endif
@@ -0,0 +1,124 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Logger.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the asynchronous logger of the system
+ * 
+ ******************************************************/
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <condition_variable>
+
+#define LOG_OFF         0
+#define LOG_ERROR       1
+#define LOG_INFO        2
+#define LOG_DEBUG       3
+
+#define LOG_SYNC        0       /*each line is written to std::cout and flushed by the thread that logs it*/
+#define LOG_ASYNC       1       /*the lines are written in batches by the background writer*/
+#define LOG_BINARY      2       /*the records are written without format, logdump formats them*/
+
+#define LOG_MAX_ARGS    4
+#define LOG_TEXT_SIZE   64
+#define LOG_RING_SIZE   4096    /*records of the ring of each thread, power of two*/
+#define LOG_FLUSH_MS    5       /*ms between two batches of the writer*/
+#define LOG_MAGIC       "CINELOG1"
+
+/******************************************************
+ * Struct name:      LogEvent
+ * Date created:     17/10/2026
+ * Purpose:          Color and format of a kind of line. Each {} is replaced by the next argument
+ *                   and {s} by the text of the record
+ * 
+ ******************************************************/
+struct LogEvent{
+    const char *color; 
+    const char *format; 
+}; 
+
+/******************************************************
+ * Struct name:      LogRecord
+ * Date created:     17/10/2026
+ * Purpose:          Line logged without format, it is also the record of the binary files
+ * 
+ ******************************************************/
+struct LogRecord{
+    long    time;       /*ns of the steady clock, it orders the lines of different threads*/
+    int     event; 
+    int     level; 
+    long    args[LOG_MAX_ARGS]; 
+    char    text[LOG_TEXT_SIZE]; 
+}; 
+
+/******************************************************
+ * Class name:       Logger
+ * Date created:     17/10/2026
+ * Input arguments:  table of events
+ * Purpose:          Logger that doesn't block the threads on the stream. Each thread writes its records in its
+ *                   own ring, with one producer and one consumer, and a background thread takes them every few
+ *                   milliseconds, orders them by time and writes the whole batch at once. The lines keep
+ *                   the colors of color.h and they never interleave
+ * 
+ ******************************************************/
+class Logger{
+    private:
+        struct alignas(64) Ring{
+            LogRecord                               records[LOG_RING_SIZE]; 
+            alignas(64) std::atomic<unsigned long>  head;   /*written by the writer*/
+            alignas(64) std::atomic<unsigned long>  tail;   /*written by the thread of the ring*/
+
+            Ring(); 
+        }; 
+
+        const LogEvent             *events; 
+        int                         level; 
+        int                         mode; 
+        FILE                       *out; 
+
+        std::vector<Ring*>          rings; 
+        std::vector<LogRecord>      pending;    /*records newer than the last batch*/
+        std::mutex                  mutex_; 
+        std::condition_variable     cv_; 
+        bool                        stopping; 
+        std::thread                 writer; 
+
+        Ring *ring(); 
+        void  add(int level, int event, const char *text, long a, long b, long c, long d); 
+        void  write(); 
+        void  flush(bool all); 
+
+    public:
+        Logger(const LogEvent *events); 
+        ~Logger(); 
+        void start(int level, int mode, std::string file = ""); 
+        void stop(); 
+        int  getLevel(); 
+        /*Method log. The level is checked here so the lines that are not shown cost only a comparison*/
+        void log(int level, int event, long a = 0, long b = 0, long c = 0, long d = 0){
+            if(level <= this->level){
+                add(level, event, nullptr, a, b, c, d); 
+            }
+        }
+        /*Method logText. The same as log with a text for {s}*/
+        void logText(int level, int event, const std::string &text, long a = 0, long b = 0, long c = 0, long d = 0){
+            if(level <= this->level){
+                add(level, event, text.c_str(), a, b, c, d); 
+            }
+        }
+
+        static std::string format(const LogEvent *events, const LogRecord &record); 
+}; 
+
+#endif
@@ -0,0 +1,90 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Metrics.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the counters, histograms and gauges of the system
+ * 
+ ******************************************************/
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <ostream>
+#include <functional>
+#include <condition_variable>
+
+#include "PerThread.h"
+
+#define METRICS_MAX_COUNTERS    32
+#define METRICS_MAX_HISTOGRAMS  16
+#define HISTOGRAM_BUCKETS       40      /*bucket i counts the values of i bits, the last one up to 2^39*/
+
+/******************************************************
+ * Class name:       Metrics
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Instrumentation that can be always on. Each thread writes in its own shard, aligned to a cache 
+ *                   line, so increment() and observe() are a load and a store without sharing lines with other threads. 
+ *                   The histograms have a bucket for each power of two. The gauges are read only when a snapshot is taken. 
+ *                   The metrics are registered before the threads start and a background thread can write 
+ *                   periodically a snapshot in Prometheus text format
+ * 
+ ******************************************************/
+class Metrics{
+    private:
+        struct alignas(64) Shard{
+            std::atomic<long>   counters[METRICS_MAX_COUNTERS]; 
+            std::atomic<long>   buckets[METRICS_MAX_HISTOGRAMS][HISTOGRAM_BUCKETS]; 
+            std::atomic<long>   sums[METRICS_MAX_HISTOGRAMS]; 
+
+            Shard(); 
+        };
+        struct Info{
+            std::string             name; 
+            std::string             help; 
+            std::function<long()>   read;   /*only the gauges*/
+        };
+
+        std::vector<Info>           counters; 
+        std::vector<Info>           histograms; 
+        std::vector<Info>           gauges; 
+        std::vector<Shard*>         shards; 
+        PerThread<Shard>            locals;     /*shard of each thread*/
+        std::mutex                  mutex_; 
+
+        std::string                 file; 
+        long                        period_ms; 
+        bool                        stopping; 
+        std::condition_variable     cv_; 
+        std::thread                 writer; 
+
+        Shard *shard(); 
+        void   write(); 
+        void   writeFile(); 
+
+    public:
+        Metrics(); 
+        ~Metrics(); 
+        int  addCounter(std::string name, std::string help); 
+        int  addHistogram(std::string name, std::string help); 
+        void addGauge(std::string name, std::string help, std::function<long()> read); 
+        void increment(int counter, long n = 1); 
+        void observe(int histogram, long value); 
+        long getCounter(int counter); 
+        long getCount(int histogram); 
+        long getShards(); 
+        void snapshot(std::ostream &out); 
+        void start(std::string file, long period_ms); 
+        void stop(); 
+}; 
+
+#endif
@@ -0,0 +1,167 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    MpmcQueue.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the bounded queue of several producers and several consumers 
+ *                  used for the requests between clients and services
+ * 
+ ******************************************************/
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+
+#define MPMC_SPIN_LIMIT     64
+
+/******************************************************
+ * Class name:       MpmcQueue
+ * Date created:     17/10/2026
+ * Input arguments:  capacity (it is rounded up to a power of 2)
+ * Purpose:          Lock-free ring buffer. Each cell has a sequence number that says if it can be written 
+ *                   (sequence == position) or read (sequence == position + 1), so producers and consumers 
+ *                   only compete with a CAS on their own index. 
+ *                   try_push/try_pop never block. push/pop spin a little and then sleep; the lock is 
+ *                   only taken when somebody is sleeping, the fast path doesn't touch it
+ * 
+ ******************************************************/
+template <typename T>
+class MpmcQueue{
+    private:
+        struct Cell{
+            std::atomic<size_t>     sequence; 
+            T                       data; 
+        };
+
+        Cell                            *buffer; 
+        size_t                          mask; 
+        alignas(64) std::atomic<size_t> enqueue_pos; 
+        alignas(64) std::atomic<size_t> dequeue_pos; 
+        alignas(64) std::atomic<int>    waiting_producers; 
+        std::atomic<int>                waiting_consumers; 
+        std::mutex                      mutex_; 
+        std::condition_variable         cv_not_empty; 
+        std::condition_variable         cv_not_full; 
+
+        /*It wakes a sleeping thread of the other side, if any*/
+        void wake(std::atomic<int> &waiting, std::condition_variable &cv){
+            std::atomic_thread_fence(std::memory_order_seq_cst); 
+            if(waiting.load(std::memory_order_relaxed) > 0){
+                { std::lock_guard<std::mutex> lg(mutex_); }
+                cv.notify_one(); 
+            }
+        }
+
+    public:
+        explicit MpmcQueue(size_t capacity): enqueue_pos(0), dequeue_pos(0), waiting_producers(0), waiting_consumers(0){
+            size_t size = 2; 
+            while(size < capacity){
+                size <<= 1; 
+            }
+            buffer = new Cell[size]; 
+            mask   = size - 1; 
+            for(size_t i = 0; i < size; i++){
+                buffer[i].sequence.store(i, std::memory_order_relaxed); 
+            }
+        }
+
+        ~MpmcQueue(){ delete[] buffer; }
+
+        MpmcQueue(const MpmcQueue &) = delete; 
+        MpmcQueue &operator=(const MpmcQueue &) = delete; 
+
+        /*Method try_push. False if the queue is full*/
+        bool try_push(const T &value){
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed); 
+            while(true){
+                Cell *cell    = &buffer[pos & mask]; 
+                size_t seq    = cell->sequence.load(std::memory_order_acquire); 
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos); 
+                if(diff == 0){
+                    if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                        cell->data = value; 
+                        cell->sequence.store(pos + 1, std::memory_order_release); 
+                        return true; 
+                    }
+                }else if(diff < 0){
+                    return false; 
+                }else{
+                    pos = enqueue_pos.load(std::memory_order_relaxed); 
+                }
+            }
+        }
+
+        /*Method try_pop. False if the queue is empty*/
+        bool try_pop(T &value){
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed); 
+            while(true){
+                Cell *cell    = &buffer[pos & mask]; 
+                size_t seq    = cell->sequence.load(std::memory_order_acquire); 
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1); 
+                if(diff == 0){
+                    if(dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                        value = cell->data; 
+                        cell->sequence.store(pos + mask + 1, std::memory_order_release); 
+                        return true; 
+                    }
+                }else if(diff < 0){
+                    return false; 
+                }else{
+                    pos = dequeue_pos.load(std::memory_order_relaxed); 
+                }
+            }
+        }
+
+        /*Method push. It blocks while the queue is full*/
+        void push(const T &value){
+            bool pushed = false; 
+            for(int i = 0; i < MPMC_SPIN_LIMIT && !(pushed = try_push(value)); i++){
+                std::this_thread::yield(); 
+            }
+            if(!pushed){
+                std::unique_lock<std::mutex> ul(mutex_); 
+                waiting_producers++; 
+                cv_not_full.wait(ul, [&]{ std::atomic_thread_fence(std::memory_order_seq_cst); return try_push(value); }); 
+                waiting_producers--; 
+            }
+            wake(waiting_consumers, cv_not_empty); 
+        }
+
+        /*Method pop. It blocks while the queue is empty*/
+        T pop(){
+            T value; 
+            bool popped = false; 
+            for(int i = 0; i < MPMC_SPIN_LIMIT && !(popped = try_pop(value)); i++){
+                std::this_thread::yield(); 
+            }
+            if(!popped){
+                std::unique_lock<std::mutex> ul(mutex_); 
+                waiting_consumers++; 
+                cv_not_empty.wait(ul, [&]{ std::atomic_thread_fence(std::memory_order_seq_cst); return try_pop(value); }); 
+                waiting_consumers--; 
+            }
+            wake(waiting_producers, cv_not_full); 
+            return value; 
+        }
+
+        /*Method size. Approximate while other threads are using the queue*/
+        size_t size(){
+            size_t head = dequeue_pos.load(std::memory_order_relaxed); 
+            size_t tail = enqueue_pos.load(std::memory_order_relaxed); 
+            return tail > head ? tail - head : 0; 
+        }
+
+        /*Method capacity*/
+        size_t capacity(){ return mask + 1; }
+}; 
+
+#endif
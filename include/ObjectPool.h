@@ -0,0 +1,183 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    ObjectPool.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the slab allocator of the requests of the clients
+ * 
+ ******************************************************/
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#define POOL_SLAB           256     /*objects of each slab*/
+#define POOL_CACHE          64      /*free objects a thread takes or gives back at once*/
+
+/******************************************************
+ * Class name:       ObjectPool
+ * Date created:     17/10/2026
+ * Input arguments:  type of the objects
+ * Purpose:          Slab allocator. The objects are in slabs of POOL_SLAB slots, each slot starts a cache line
+ *                   so two objects never share one. A free slot keeps the next free one in its first bytes.
+ *                   Each thread has a cache of free slots and only takes the lock to move POOL_CACHE slots
+ *                   between its cache and the pool, so the thread that creates the clients and the workers that
+ *                   free them don't meet at every request. The slabs are freed with the pool.
+ *                   With setPooled(false) it is new and delete, to compare
+ * 
+ ******************************************************/
+template <typename T>
+class ObjectPool{
+    private:
+        struct alignas(64) Slot{
+            alignas(T) unsigned char bytes[sizeof(T)]; 
+        }; 
+        struct Free{
+            Free *next; 
+        }; 
+        struct Cache{
+            ObjectPool *pool    = nullptr; 
+            Free       *head    = nullptr; 
+            int         count   = 0; 
+
+            ~Cache(){
+                if(pool != nullptr){
+                    pool->giveBack(*this, count); 
+                }
+            }
+        }; 
+
+        std::vector<Slot*>  slabs; 
+        Free               *free_list; 
+        long                free_count; 
+        bool                pooled; 
+        std::atomic<long>   live; 
+        std::mutex          mutex_; 
+
+        static thread_local Cache cache; 
+
+        /*Method giveBack. n slots of the cache go back to the pool*/
+        void giveBack(Cache &c, int n){
+            if(n <= 0){
+                return; 
+            }
+            Free *first = c.head; 
+            Free *last  = first; 
+            for(int i = 1; i < n; i++){
+                last = last->next; 
+            }
+            c.head   = last->next; 
+            c.count -= n; 
+            std::lock_guard<std::mutex> lg(mutex_); 
+            last->next  = free_list; 
+            free_list   = first; 
+            free_count += n; 
+        }
+
+        /*Method refill. The cache takes POOL_CACHE slots, from a new slab if the pool has none*/
+        void refill(Cache &c){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            if(free_list == nullptr){
+                Slot *slab = new Slot[POOL_SLAB]; 
+                slabs.push_back(slab); 
+                for(int i = POOL_SLAB - 1; i >= 0; i--){
+                    Free *f    = reinterpret_cast<Free*>(&slab[i]); 
+                    f->next    = free_list; 
+                    free_list  = f; 
+                }
+                free_count += POOL_SLAB; 
+            }
+            for(int i = 0; i < POOL_CACHE && free_list != nullptr; i++){
+                Free *f    = free_list; 
+                free_list  = f->next; 
+                f->next    = c.head; 
+                c.head     = f; 
+                c.count++; 
+                free_count--; 
+            }
+        }
+
+        /*Method local. Cache of the thread for this pool, the cache of another pool is given back before*/
+        Cache &local(){
+            Cache &c = cache; 
+            if(c.pool != this){
+                if(c.pool != nullptr){
+                    c.pool->giveBack(c, c.count); 
+                }
+                c.pool = this; 
+            }
+            return c; 
+        }
+
+    public:
+        ObjectPool(): free_list(nullptr), free_count(0), pooled(true), live(0){}
+
+        ~ObjectPool(){
+            if(cache.pool == this){ /*the other threads have given back their caches when they ended*/
+                cache = Cache(); 
+            }
+            for(unsigned i = 0; i < slabs.size(); i++){
+                delete[] slabs[i]; 
+            }
+        }
+
+        /*Method setPooled. Before the first object, false uses new and delete*/
+        void setPooled(bool p){ pooled = p; }
+
+        /*Method create. It builds the object in a free slot*/
+        template <typename... Args>
+        T *create(Args&&... args){
+            live++; 
+            if(!pooled){
+                return new T(std::forward<Args>(args)...); 
+            }
+            Cache &c = local(); 
+            if(c.head == nullptr){
+                refill(c); 
+            }
+            Free *f = c.head; 
+            c.head  = f->next; 
+            c.count--; 
+            return new(f) T(std::forward<Args>(args)...); 
+        }
+
+        /*Method destroy. The slot goes to the cache of the thread, half of it goes back if it is full*/
+        void destroy(T *object){
+            live--; 
+            if(!pooled){
+                delete object; 
+                return; 
+            }
+            object->~T(); 
+            Cache &c = local(); 
+            Free *f  = reinterpret_cast<Free*>(object); 
+            f->next  = c.head; 
+            c.head   = f; 
+            c.count++; 
+            if(c.count >= 2 * POOL_CACHE){
+                giveBack(c, POOL_CACHE); 
+            }
+        }
+
+        /*Method getSlabs. Allocations of the pool*/
+        long getSlabs(){
+            std::lock_guard<std::mutex> lg(mutex_); 
+            return slabs.size(); 
+        }
+
+        /*Method getLive. Objects created and not destroyed*/
+        long getLive(){ return live; }
+}; 
+
+template <typename T>
+thread_local typename ObjectPool<T>::Cache ObjectPool<T>::cache; 
+
+#endif
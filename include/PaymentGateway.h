@@ -0,0 +1,112 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    PaymentGateway.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the asynchronous payment gateway
+ * 
+ ******************************************************/
+#ifndef PAYMENTGATEWAY_H
+#define PAYMENTGATEWAY_H
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+#include "msgRequest.h"
+#include "SemCounter.h"
+#include "Clock.h"
+#include "FairScheduler.h"
+#include "ObjectPool.h"
+
+#define LATENCY_CONSTANT        0
+#define LATENCY_UNIFORM         1       /*between 0 and twice the mean*/
+#define LATENCY_EXPONENTIAL     2
+#define PAYMENT_CLASSES         2       /*the type of the payment is its class: 1 tickets, 2 food*/
+
+/******************************************************
+ * Class name:       PaymentGateway
+ * Date created:     17/10/2026
+ * Input arguments:  maximum authorizations in flight, mean latency in microseconds, 
+ *                   distribution of the latency, probability of failure, 
+ *                   turns of the tickets for each turn of the food, starvation bound in microseconds and 
+ *                   virtual clock (nullptr to run in real time)
+ * Purpose:          It sends the payments to a stub processor keeping up to K authorizations in flight. 
+ *                   The dispatcher takes a permit of the window and sends the request chosen by the fair scheduler, 
+ *                   the completer answers the requests when their deadline arrives and gives back the permit. 
+ *                   The requester receives the result in a callback or in a future. 
+ *                   With a virtual clock the deadlines are events of the clock and there is no completer
+ * 
+ ******************************************************/
+class PaymentGateway{
+    public:
+        typedef std::chrono::steady_clock           SteadyClock; 
+        typedef std::function<void(bool approved)>  Callback; 
+
+    private:
+        struct Authorization{
+            MsgRequestPayment   *mrp; 
+            Callback            on_done; 
+            SteadyClock::time_point deadline; 
+        };
+        struct Later{
+            bool operator()(const Authorization *a, const Authorization *b) const { return a->deadline > b->deadline; }
+        };
+
+        int                             window; 
+        long                            latency_us; 
+        int                             distribution; 
+        double                          failure_rate; 
+        std::mt19937                    rng; 
+        std::mt19937                    rng_failures; 
+        VirtualClock                   *clock; 
+
+        ObjectPool<Authorization>       authorizations; /*one for each payment until it is answered*/
+        FairScheduler<Authorization*>   pending;        /*requests not sent yet, one class for each type of payment*/
+        SemCounter                      permits;        /*free places of the window*/
+        std::priority_queue<Authorization*, std::vector<Authorization*>, Later> in_flight; 
+        std::mutex                      mutex_; 
+        std::condition_variable         cv_; 
+        bool                            stopping; 
+        long                            num_approved; 
+        long                            num_rejected; 
+        int                             num_in_flight; 
+        int                             max_in_flight; 
+        std::thread                     dispatcher; 
+        std::thread                     completer; 
+
+        void dispatch(); 
+        void complete(); 
+        long sampleLatency(); 
+        bool decide(); 
+        void answer(Authorization *auth, bool approved); 
+        int  paymentClass(int type); 
+
+    public:
+        PaymentGateway(int window, long latency_us, int distribution, double failure_rate, int ratio, long starvation_us, VirtualClock *clock = nullptr, 
+                       unsigned long seed = 0); 
+        ~PaymentGateway(); 
+        void              authorize(MsgRequestPayment *mrp, Callback on_done); 
+        std::future<bool> authorize(MsgRequestPayment *mrp); 
+        void              stop(); 
+        void              setPooled(bool pooled); 
+        int               getWindow(); 
+        long              getApproved(); 
+        long              getRejected(); 
+        int               getMaxInFlight(); 
+        int               getInFlight(); 
+        long              getWaitPercentile(int type, double p); 
+        long              getStarved(); 
+}; 
+
+#endif
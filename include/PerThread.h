@@ -0,0 +1,143 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    PerThread.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the cache of the object of each thread of an instance
+ * 
+ ******************************************************/
+#ifndef PERTHREAD_H
+#define PERTHREAD_H
+
+#include <mutex>
+#include <atomic>
+#include <unordered_set>
+
+#define PERTHREAD_ENTRIES   8       /*instances a thread remembers of each type*/
+
+/******************************************************
+ * Class name:       PerThread
+ * Date created:     17/10/2026
+ * Input arguments:  type of the objects
+ * Purpose:          It finds the object of the thread of an instance, the ring of the Ledger or the shard of the 
+ *                   Metrics. Each instance has an id that is never reused, so an instance built at the address of 
+ *                   one that was destroyed doesn't find its objects, and each thread keeps the ids of the last 
+ *                   PERTHREAD_ENTRIES instances it used, so a thread that goes from one instance to another doesn't 
+ *                   create a new object every time. The table of the thread has no destructor so the instances 
+ *                   that are destroyed at the exit of the program can still use it. The instance keeps and frees 
+ *                   its objects; when it is destroyed it drops its entry from the thread that destroys it and the 
+ *                   other threads reuse the entry the next time they need one
+ * 
+ ******************************************************/
+template <typename T>
+class PerThread{
+    private:
+        struct Entry{
+            unsigned long   id;         /*0 if the entry is free*/
+            T              *object; 
+        }; 
+
+        unsigned long       id; 
+
+        static thread_local Entry       table[PERTHREAD_ENTRIES]; 
+        static thread_local unsigned    victim;     /*next entry replaced when none is free*/
+
+        static std::mutex &mutex(){
+            static std::mutex m; 
+            return m; 
+        }
+
+        /*Ids of the instances alive, with mutex() locked*/
+        static std::unordered_set<unsigned long> &alive(){
+            static std::unordered_set<unsigned long> ids; 
+            return ids; 
+        }
+
+        static unsigned long nextId(){
+            static std::atomic<unsigned long> next(1); 
+            return next.fetch_add(1, std::memory_order_relaxed); 
+        }
+
+        /*It frees the entries of the thread of the instances that were destroyed*/
+        static void prune(){
+            std::lock_guard<std::mutex> lg(mutex()); 
+            for(int i = 0; i < PERTHREAD_ENTRIES; i++){
+                if(table[i].id != 0 && alive().count(table[i].id) == 0){
+                    table[i].id = 0; 
+                }
+            }
+        }
+
+    public:
+        PerThread(): id(nextId()){
+            std::lock_guard<std::mutex> lg(mutex()); 
+            alive().insert(id); 
+        }
+
+        ~PerThread(){
+            {
+                std::lock_guard<std::mutex> lg(mutex()); 
+                alive().erase(id); 
+            }
+            for(int i = 0; i < PERTHREAD_ENTRIES; i++){
+                if(table[i].id == id){
+                    table[i].id = 0; 
+                }
+            }
+        }
+
+        PerThread(const PerThread&) = delete; 
+        PerThread &operator=(const PerThread&) = delete; 
+
+        /*Method get. Object of the thread, nullptr if the thread hasn't set one. The entry found goes to 
+          the front so the instance the thread is using is found at the first try*/
+        T *get(){
+            Entry *t = table; 
+            if(t[0].id == id){
+                return t[0].object; 
+            }
+            for(int i = 1; i < PERTHREAD_ENTRIES; i++){
+                if(t[i].id == id){
+                    Entry found = t[i]; 
+                    t[i] = t[0]; 
+                    t[0] = found; 
+                    return found.object; 
+                }
+            }
+            return nullptr; 
+        }
+
+        /*Method set. Object of the thread from now on. If every entry is in use the instance that was replaced 
+          gives the thread a new object the next time*/
+        void set(T *object){
+            int slot = -1; 
+            for(int round = 0; round < 2 && slot < 0; round++){
+                if(round == 1){
+                    prune(); 
+                }
+                for(int i = 0; i < PERTHREAD_ENTRIES && slot < 0; i++){
+                    if(table[i].id == 0){
+                        slot = i; 
+                    }
+                }
+            }
+            if(slot < 0){
+                slot   = victim; 
+                victim = (victim + 1) % PERTHREAD_ENTRIES; 
+            }
+            table[slot].id      = id; 
+            table[slot].object  = object; 
+        }
+}; 
+
+template <typename T>
+thread_local typename PerThread<T>::Entry PerThread<T>::table[PERTHREAD_ENTRIES]; 
+
+template <typename T>
+thread_local unsigned PerThread<T>::victim = 0; 
+
+#endif
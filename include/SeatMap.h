@@ -0,0 +1,60 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    SeatMap.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the map of seats of a hall
+ * 
+ ******************************************************/
+#ifndef SEATMAP_H
+#define SEATMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <string>
+
+/******************************************************
+ * Class name:       SeatMap
+ * Date created:     17/10/2026
+ * Input arguments:  number of rows and seats per row
+ * Purpose:          State of each seat of the hall. Each row is a packed bitset (1 = free seat) so a 
+ *                   block of N adjacent seats is searched a 64 bit word at a time. Each row keeps a bound of its 
+ *                   largest block of free seats, so the rows that can't give a block are skipped without reading them. 
+ *                   The id of a seat is row * cols + col. It isn't synchronized, the owner must lock it
+ * 
+ ******************************************************/
+class SeatMap{
+    private:
+        int                     rows;
+        int                     cols;
+        int                     words_per_row; 
+        int                     num_free; 
+        std::vector<uint64_t>   free_bits;      /*words of row r start in r * words_per_row*/
+        std::vector<int>        free_per_row; 
+        std::vector<int>        run_per_row;    /*largest block of free seats of each row or more*/
+        std::vector<char>       run_exact;      /*1 if run_per_row is the largest block, a sale can make it smaller*/
+
+        int  findBlock(int row, int n); 
+        int  longestRun(int row); 
+        int  runAt(int row, int col); 
+        int  largestRun(int row); 
+        void take(int row, int col, int n, std::vector<int> &seats); 
+
+    public:
+        SeatMap(int rows, int cols); 
+        bool allocate(int n, std::vector<int> &seats); 
+        bool allocateSeat(int seat); 
+        void release(const std::vector<int> &seats); 
+        bool isFree(int seat); 
+        int  getFree(); 
+        int  getRows(); 
+        int  getCols(); 
+        int  getCapacity(); 
+        std::string seatName(int seat); 
+}; 
+
+#endif
@@ -10,22 +10,38 @@
  * Purpose:         Contain the definitions of counter semaphore
  * 
  ******************************************************/
+#ifndef SEMCOUNTER_H
+#define SEMCOUNTER_H
+
 #include <iostream>
 #include <thread>
-#include<mutex>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
 
+/******************************************************
+ * Class name:       SemCounter
+ * Date created:     4/4/2020
+ * Input arguments:  initial number of permits
+ * Purpose:          Counting semaphore. value is the number of permits available, 
+ *                   wait() blocks while it is zero and signal() wakes the waiters 
+ *                   without delay
+ * 
+ ******************************************************/
 class SemCounter{
     private:
         int value;
         std::mutex mutex_; 
-        std::mutex mutex_block; 
-
-        void block();
-        void unblock(); 
+        std::condition_variable cv_; 
 
     public:
         SemCounter(int value); 
         void wait();
+        bool try_wait(); 
+        bool wait_for(std::chrono::nanoseconds timeout); 
         void signal(); 
+        void signal(int n); 
         int getValue(); 
-}; 
\ No newline at end of file
+}; 
+
+#endif
@@ -0,0 +1,249 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Stage.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the stages of the pipeline of the sales: workers that take typed messages from
+ *                  bounded queues, process them and give the result to the next stage
+ * 
+ ******************************************************/
+#ifndef STAGE_H
+#define STAGE_H
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <functional>
+#include <type_traits>
+
+#include "LatencyStats.h"
+
+/*How a stage chooses the worker of a message*/
+#define ROUTE_KEY           0   /*the key of the message gives the worker, each worker keeps the order of its queue*/
+#define ROUTE_BALANCE       1   /*an idle worker or, if all are busy, the shorter queue of two*/
+
+/******************************************************
+ * Class name:       Stage
+ * Date created:     17/10/2026
+ * Input arguments:  name, workers, capacity of each queue, routing, stealing and the runtime of the services
+ * Purpose:          Stage of the pipeline from In to Out. Each worker has its own bounded queue, so a full queue
+ *                   stops the stage that sends to it (backpressure), and sleeps in its own wakeup while it has
+ *                   nothing to do. A message is given to one worker and only that worker, or one idle worker if
+ *                   the stage steals, is woken. With stealing a worker without messages takes them from the others.
+ *                   The handler gives the Out of each message, or an empty one if it is answered later, and the
+ *                   Out goes to the next stage or to the sink.
+ *                   Runtime says how the services run: Queue<T> and Wakeup are its queue and semaphore, Result<T>
+ *                   what the handler gives back (T or a coroutine that gives it), send() and signal() use them and
+ *                   now() is the time in microseconds. The loop of the workers belongs to the runtime too, it uses
+ *                   take(), idle(), process(), record() and emit().
+ *                   The stage keeps the wait in the queue and the service time of each message and the time
+ *                   its workers are busy, to give the utilization
+ * 
+ ******************************************************/
+template <typename In, typename Out, typename Runtime>
+class Stage{
+    public:
+        typedef In                                      input_type; 
+        typedef Out                                     output_type; 
+        typedef typename Runtime::template Result<Out>  Result; 
+
+        struct Item{
+            In      msg;    /*empty to stop the worker*/
+            long    at;     /*microseconds when it was sent*/
+        }; 
+
+    private:
+        static_assert(std::is_pointer<In>::value && std::is_pointer<Out>::value, "the messages are pointers, an empty one stops or answers later"); 
+
+        typedef typename Runtime::template Queue<Item>  Queue; 
+        typedef typename Runtime::Wakeup                Wakeup; 
+
+        /*Each worker starts its own cache line, the senders write its queue and its idle flag*/
+        struct alignas(64) Worker{
+            Queue               queue; 
+            std::atomic<bool>   sleeping{false}; 
+            Wakeup              wakeup{0}; 
+
+            Worker(int capacity): queue(capacity){}
+        }; 
+
+        std::string                         name; 
+        std::vector<Worker*>                workers; 
+        int                                 routing; 
+        bool                                stealing; 
+        int                                 idle_metric;    /*histogram of the time the workers sleep, -1 none*/
+        std::function<unsigned(In)>         key;            /*worker of each message with ROUTE_KEY*/
+        std::function<Result(In, unsigned)> handler; 
+        std::function<void(Out)>            sink;           /*next stage or end of the pipeline*/
+        std::function<void(unsigned)>       on_error;       /*a message of the worker has failed*/
+        std::atomic<unsigned>               next{0};        /*worker where the search of ROUTE_BALANCE starts*/
+        alignas(64) std::atomic<long>       processed{0}; 
+        std::atomic<long>                   steals{0}; 
+        std::atomic<long>                   busy_us{0}; 
+        long                                opened_at; 
+        LatencyStats                        waits; 
+        LatencyStats                        services; 
+
+        /*Worker of the message*/
+        unsigned route(In msg){
+            unsigned n = workers.size(); 
+            if(routing == ROUTE_KEY){
+                return key(msg) % n; 
+            }
+            unsigned first = next++ % n; 
+            for(unsigned k = 0; k < n; k++){
+                if(workers[(first + k) % n]->sleeping.load()){
+                    return (first + k) % n; 
+                }
+            }
+            return workers[(first + 1) % n]->queue.size() < workers[first]->queue.size() ? (first + 1) % n : first; 
+        }
+
+        /*It wakes the worker of the queue or, with stealing, the first idle one from it*/
+        void wake(unsigned w){
+            unsigned n = workers.size(); 
+            for(unsigned k = 0; k < (stealing ? n : 1); k++){
+                Worker *worker = workers[(w + k) % n]; 
+                if(worker->sleeping.load() && worker->sleeping.exchange(false)){
+                    Runtime::signal(worker->wakeup); 
+                    return; 
+                }
+            }
+        }
+
+    public:
+        Stage(std::string name, int num_workers, int capacity, int routing, bool stealing):
+            name(name), routing(routing), stealing(stealing), idle_metric(-1),
+            opened_at(Runtime::now()), waits(name + "_queue"), services(name + "_service"){
+            for(int w = 0; w < num_workers; w++){
+                workers.push_back(new Worker(capacity)); 
+            }
+        }
+
+        ~Stage(){
+            for(unsigned w = 0; w < workers.size(); w++){
+                delete workers[w]; 
+            }
+        }
+
+        Stage(const Stage &) = delete; 
+        Stage &operator=(const Stage &) = delete; 
+
+        /*Method setHandler. Function that processes each message in the worker*/
+        void setHandler(std::function<Result(In, unsigned)> h){ handler = std::move(h); }
+
+        /*Method setKey. Worker of each message, only with ROUTE_KEY*/
+        void setKey(std::function<unsigned(In)> k){ key = std::move(k); }
+
+        /*Method setSink. The outputs leave the pipeline through the function*/
+        void setSink(std::function<void(Out)> s){ sink = std::move(s); }
+
+        /*Method setOnError*/
+        void setOnError(std::function<void(unsigned)> e){ on_error = std::move(e); }
+
+        /*Method setIdleMetric*/
+        void setIdleMetric(int metric){ idle_metric = metric; }
+
+        /*Method connect. The outputs go to the next stage, its input must be the output of this one*/
+        template <typename NextOut>
+        void connect(Stage<Out, NextOut, Runtime> &next_stage){
+            sink = [&next_stage](Out msg){ next_stage.submit(msg); }; 
+        }
+
+        /*Method submit. It blocks while the queue of the worker is full*/
+        void submit(In msg){
+            unsigned w = route(msg); 
+            Runtime::send(workers[w]->queue, Item{msg, Runtime::now()}); 
+            std::atomic_thread_fence(std::memory_order_seq_cst); 
+            wake(w); 
+        }
+
+        /*Method close. An empty message for each worker, they end when they take it*/
+        void close(){
+            for(unsigned w = 0; w < workers.size(); w++){
+                Runtime::send(workers[w]->queue, Item{nullptr, Runtime::now()}); 
+            }
+            std::atomic_thread_fence(std::memory_order_seq_cst); 
+            for(unsigned w = 0; w < workers.size(); w++){
+                Runtime::signal(workers[w]->wakeup); 
+            }
+        }
+
+        /*Method take. The next message of the worker or, with stealing, of another one*/
+        bool take(unsigned w, Item &item){
+            if(workers[w]->queue.try_pop(item)){
+                return true; 
+            }
+            for(unsigned k = 1; stealing && k < workers.size(); k++){
+                if(workers[(w + k) % workers.size()]->queue.try_pop(item)){
+                    steals++; 
+                    return true; 
+                }
+            }
+            return false; 
+        }
+
+        /*Method idle. The worker goes to sleep, a sender that finds it so wakes it. It is marked before the
+          queues are checked again, so a message that arrives meanwhile is never lost*/
+        void idle(unsigned w, bool sleeping){
+            workers[w]->sleeping = sleeping; 
+            std::atomic_thread_fence(std::memory_order_seq_cst); 
+        }
+
+        /*Method wakeup. Semaphore where the worker sleeps*/
+        Wakeup &wakeup(unsigned w){ return workers[w]->wakeup; }
+
+        /*Method process*/
+        Result process(In msg, unsigned w){ return handler(msg, w); }
+
+        /*Method record. Wait in the queue and service time of a message*/
+        void record(long wait_us, long service_us){
+            waits.record(wait_us); 
+            services.record(service_us); 
+            busy_us += service_us; 
+            processed++; 
+        }
+
+        /*Method emit*/
+        void emit(Out msg){
+            if(sink){
+                sink(msg); 
+            }
+        }
+
+        /*Method fail*/
+        void fail(unsigned w){
+            if(on_error){
+                on_error(w); 
+            }
+        }
+
+        /*Method depth. Messages waiting in every queue*/
+        long depth(){
+            long d = 0; 
+            for(unsigned w = 0; w < workers.size(); w++){
+                d += workers[w]->queue.size(); 
+            }
+            return d; 
+        }
+
+        /*Method getUtilization. Fraction of the time since the stage opened that its workers were busy*/
+        double getUtilization(long now){
+            long elapsed = (now - opened_at) * static_cast<long>(workers.size()); 
+            return elapsed > 0 ? static_cast<double>(busy_us.load()) / elapsed : 0; 
+        }
+
+        std::string     getName(){ return name; }
+        unsigned        getNumWorkers(){ return workers.size(); }
+        int             getIdleMetric(){ return idle_metric; }
+        long            getProcessed(){ return processed.load(); }
+        long            getSteals(){ return steals.load(); }
+        LatencyStats   &getWaits(){ return waits; }
+        LatencyStats   &getServices(){ return services; }
+}; 
+
+#endif
@@ -0,0 +1,49 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    ThreadPool.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the fixed pool of workers that runs the client sessions
+ * 
+ ******************************************************/
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+/******************************************************
+ * Class name:       ThreadPool
+ * Date created:     17/10/2026
+ * Input arguments:  number of workers (0 means one per core)
+ * Purpose:          Fixed number of threads that take tasks from a FIFO queue. 
+ *                   The tasks must not block, a client that has to wait is submitted again when it is attended
+ * 
+ ******************************************************/
+class ThreadPool{
+    private:
+        std::vector<std::thread>            workers;
+        std::queue<std::function<void()>>   tasks;
+        std::mutex                          mutex_; 
+        std::condition_variable             cv_; 
+        bool                                stop; 
+
+        void work(); 
+
+    public:
+        ThreadPool(int num_workers); 
+        ~ThreadPool(); 
+        void submit(std::function<void()> task); 
+        void shutdown(); 
+        int  size(); 
+}; 
+
+#endif
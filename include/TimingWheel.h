@@ -0,0 +1,75 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    TimingWheel.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the hierarchical timing wheel of the holds
+ * 
+ ******************************************************/
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#define WHEEL_LEVELS        4                           /*64^4 ticks, 4.6 hours with ticks of 1 ms*/
+#define WHEEL_BITS          6
+#define WHEEL_SLOTS         (1 << WHEEL_BITS)
+#define WHEEL_MASK          (WHEEL_SLOTS - 1)
+#define WHEEL_RANGE         (1L << (WHEEL_LEVELS * WHEEL_BITS))
+
+/******************************************************
+ * Class name:       TimingWheel
+ * Date created:     17/10/2026
+ * Input arguments:  microseconds of each tick
+ * Purpose:          Timers of the holds in a hierarchical wheel. The level 0 has a slot for each of the next 64 ticks,
+ *                   each slot of the level 1 covers 64 ticks and so on; when the level 0 goes round, the next slot
+ *                   of the level 1 is spread over the level 0. Arm and cancel are O(1): the timers live in a pool
+ *                   and each slot is a doubly linked list of indexes. Only one thread calls expire(), it runs the
+ *                   callbacks of each tick out of the lock, so the ticket offices can keep arming during a burst
+ * 
+ ******************************************************/
+class TimingWheel{
+    private:
+        struct Node{
+            long        expires;    /*tick*/
+            void       *data; 
+            unsigned    generation; /*it changes when the node is freed, so an old handle doesn't match*/
+            int         slot;       /*-1 if the node is free*/
+            int         prev; 
+            int         next; 
+        }; 
+
+        long                    tick_us; 
+        long                    current;    /*next tick to expire*/
+        long                    armed; 
+        long                    fired; 
+        std::vector<Node>       nodes; 
+        int                     free_list; 
+        int                     heads[WHEEL_LEVELS * WHEEL_SLOTS]; 
+        bool                    firing;     /*the callbacks of a tick are running*/
+        std::mutex              mutex_; 
+        std::condition_variable fired_; 
+
+        void place(int index); 
+        void link(int index, int slot); 
+        void unlink(int index); 
+        void cascade(int level); 
+        void release(int index); 
+
+    public:
+        TimingWheel(long tick_us); 
+        unsigned long arm(long deadline_us, void *data, bool *first = nullptr); 
+        bool          cancel(unsigned long handle); 
+        long          expire(long now_us, const std::function<void(void*)> &callback); 
+        long          getArmed(); 
+        long          getFired(); 
+}; 
+
+#endif
@@ -0,0 +1,44 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    WaitSlot.h
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the slot where a thread waits to be handed the turn
+ * 
+ ******************************************************/
+#ifndef WAITSLOT_H
+#define WAITSLOT_H
+
+#include <atomic>
+
+/******************************************************
+ * Class name:       WaitSlot
+ * Date created:     17/10/2026
+ * Input arguments:  initial number of permits
+ * Purpose:          Counting semaphore over a futex word, for the waits that belong to one request or one 
+ *                   service. permits is the futex word itself: wait() sleeps in the kernel only while it is 0 
+ *                   and signal() adds a permit and wakes exactly one sleeper, and only if there is one. 
+ *                   There is no mutex, so the thread woken doesn't wait for a lock the signaller still holds
+ * 
+ ******************************************************/
+class WaitSlot{
+    private:
+        alignas(4) std::atomic<int> permits; 
+        std::atomic<int>            sleepers; 
+
+    public:
+        WaitSlot(int value); 
+        void wait(); 
+        bool try_wait(); 
+        void signal(); 
+        int  getValue(); 
+
+        WaitSlot(const WaitSlot &) = delete; 
+        WaitSlot &operator=(const WaitSlot &) = delete; 
+}; 
+
+#endif
@@ -0,0 +1,109 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Workload.h
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the definitions of the generator of the arrivals of the clients
+ * 
+ ******************************************************/
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include <random>
+
+#define ARRIVAL_FIXED       0       /*a client each 1/rate seconds*/
+#define ARRIVAL_POISSON     1       /*exponential time between clients*/
+#define ARRIVAL_BURSTY      2       /*Poisson whose rate goes up during the rushes*/
+#define ARRIVAL_TRACE       3       /*arrivals read from a CSV file*/
+
+#define DIST_UNIFORM        0
+#define DIST_FIXED          1
+#define DIST_POISSON        2
+#define DIST_GEOMETRIC      3
+
+/******************************************************
+ * Struct name:      Arrival
+ * Date created:     17/10/2026
+ * Purpose:          Client of the workload and the microseconds since the start when it arrives
+ * 
+ ******************************************************/
+struct Arrival{
+    long    at_us; 
+    int     showing; 
+    int     seats; 
+    int     drinks; 
+    int     popcorn; 
+    int     showings;   /*showings of the order, more than 1 for a group that books them all or none*/
+}; 
+
+/******************************************************
+ * Struct name:      Distribution
+ * Date created:     17/10/2026
+ * Purpose:          Distribution of a quantity of the request, the values are always between min and max
+ * 
+ ******************************************************/
+struct Distribution{
+    int     kind; 
+    double  a;          /*minimum, value, mean or probability of success*/
+    double  b;          /*maximum of the uniform*/
+    int     min; 
+    int     max; 
+}; 
+
+/******************************************************
+ * Class name:       Workload
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Generator of the clients. The arrivals can be fixed, Poisson, bursty or read from a trace
+ *                   and the seats, drinks and popcorn follow their own distributions. The random numbers come
+ *                   from generators seeded from one seed, one for each thread that asks for a stream,
+ *                   so the same seed gives the same clients in every run. Only one thread calls next
+ * 
+ ******************************************************/
+class Workload{
+    private:
+        int                     arrivals; 
+        double                  rate;           /*clients per second, 0 all at once*/
+        double                  burst_factor;   /*the rate is multiplied by it during the rushes*/
+        double                  burst_on_s;     /*mean duration of a rush*/
+        double                  burst_off_s;    /*mean time between rushes*/
+        Distribution            seats; 
+        Distribution            drinks; 
+        Distribution            popcorn; 
+        double                  group_share;    /*fraction of the clients that are a group order*/
+        int                     group_showings; 
+        std::vector<Arrival>    trace; 
+        std::string             spec; 
+
+        unsigned long           seed; 
+        std::mt19937_64         rng; 
+        long                    now_us; 
+        bool                    in_burst; 
+        long                    state_end_us; 
+        size_t                  next_trace; 
+
+        int  sample(const Distribution &d); 
+        long interarrival(double r); 
+        bool loadTrace(std::string file); 
+        static bool parseDistribution(std::string spec, int min, int max, Distribution &d); 
+
+    public:
+        Workload(unsigned long seed); 
+        bool          setArrivals(std::string spec, double rate); 
+        bool          setDistributions(std::string spec, int max_seats, int max_food); 
+        void          setGroups(double share, int showings); 
+        int           getNumClients(int requested); 
+        unsigned long getSeed(); 
+        std::string   getArrivals(); 
+        Arrival       next(int showings); 
+
+        static std::mt19937_64 stream(unsigned long seed, unsigned long id); 
+}; 
+
+#endif
@@ -11,24 +11,48 @@
  * 
  ******************************************************/
 
+#ifndef MSGREQUEST_H
+#define MSGREQUEST_H
+
 #include <iostream>
+#include <functional>
+#include <vector>
+#include <atomic>
+
+#include "Inventory.h"
+
+/*Who owns a request: the client until it is posted, then the service until complete()*/
+#define REQUEST_IDLE        0
+#define REQUEST_QUEUED      1
+#define REQUEST_DONE        2
 
 /******************************************************
  * Class name:       MsgRequestTickets
  * Date created:     3/4/2020
  * Input arguments: 
  * Purpose:          Class of requests to ticket office 
- *                   The client indicates id of the client and number of seats that wants. The ticket office 
- *                   show if it has seats sufficient
+ *                   The client indicates id of the client, the showing and number of seats that wants. The ticket office 
+ *                   show if it has seats sufficient and the ids of the seats given. A group order has a leg for 
+ *                   each of its showings, it is sent to the ticket office of the first one and gets all of them or none
  * 
  ******************************************************/
 class MsgRequestTickets{
     public:
         int     id_client;
         int     num_seats;
+        int     showing;
         bool    suff_seats;
+        std::vector<int> seats;              /*ids of the seats given by the ticket office*/
+        std::vector<BookingLeg> legs;        /*showings of a group order, empty for one showing*/
+        long    requested_at;                /*microseconds when the client sent the request*/
+        long    served_at;                   /*microseconds when the ticket office took it*/
+        std::function<void()> on_attended;   /*resumes the client when the ticket office answers*/
+        std::atomic<int> status;             /*REQUEST_IDLE, REQUEST_QUEUED or REQUEST_DONE*/
 
-        MsgRequestTickets(int id, int ns);
+        MsgRequestTickets(int id, int ns, int sh = 1);
+        void post();
+        void complete();
+        bool inFlight();
 };
 
 
@@ -47,7 +71,15 @@ class MsgRequestSalePoint{
         int     num_popcorn;
         int     id_sp_attend; 
         bool    attended;
+        long    requested_at;                /*microseconds when the client sent the request*/
+        long    served_at;                   /*microseconds when the sale point took it*/
+        std::function<void()> on_attended;   /*resumes the client when the sale point answers*/
+        std::atomic<int> status;             /*REQUEST_IDLE, REQUEST_QUEUED or REQUEST_DONE*/
+
         MsgRequestSalePoint(int id, int nd, int np); 
+        void post();
+        void complete();
+        bool inFlight();
 };
 
 
@@ -63,6 +95,11 @@ class MsgRequestPayment{
         int  id_client;
         int  type; 
         bool attended; 
+        bool approved;      /*result of the payment processor*/
+        long requested_at;  /*microseconds when it was sent to the gateway*/
+        std::function<void()> on_paid;  /*runs when the gateway answers, the request can be freed in it*/
 
         MsgRequestPayment(int id, int t); 
-};
\ No newline at end of file
+};
+
+#endif
@@ -0,0 +1,140 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Clock.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the real and the virtual clock
+ * 
+ ******************************************************/
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+#include "../include/Clock.h"
+
+/*Constructor of the real clock*/
+RealClock::RealClock(double s): scale(s), start(std::chrono::steady_clock::now()){}
+
+/*Method now. Real time divided by the scale*/
+long RealClock::now(){
+    if(scale <= 0){
+        return 0; 
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / scale; 
+}
+
+/*Method sleepFor*/
+void RealClock::sleepFor(long us){
+    if(scale > 0 && us > 0){
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(us * scale))); 
+    }
+}
+
+/*Constructor of the virtual clock. The thread that creates it is running*/
+VirtualClock::VirtualClock(): current(0), seq(0), active(1), num_events(0){}
+
+/*Method advance. While no thread can run, it jumps to the next event and wakes its thread or runs its function*/
+void VirtualClock::advance(std::unique_lock<std::mutex> &ul){
+    while(active == 0 && !events.empty()){
+        Event event = events.top(); 
+        events.pop(); 
+        current = event.time; 
+        num_events++; 
+        active++; 
+        if(event.sleeper != nullptr){
+            event.sleeper->done = true; 
+            event.sleeper->cv.notify_one(); 
+        }else{
+            ul.unlock(); 
+            event.fn(); 
+            ul.lock(); 
+            active--; 
+        }
+    }
+}
+
+/*Method now*/
+long VirtualClock::now(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return current; 
+}
+
+/*Method sleepFor. The thread stops running until the time of its event*/
+void VirtualClock::sleepFor(long us){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    Sleeper sleeper; 
+    sleeper.done = false; 
+    Event event  = {current + (us > 0 ? us : 0), seq++, &sleeper, nullptr}; 
+    events.push(event); 
+    active--; 
+    advance(ul); 
+    while(!sleeper.done){
+        sleeper.cv.wait(ul); 
+    }
+}
+
+/*Method enter. A new thread of the simulation is going to run*/
+void VirtualClock::enter(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    active++; 
+}
+
+/*Method leave. A thread of the simulation has ended*/
+void VirtualClock::leave(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    active--; 
+    advance(ul); 
+}
+
+/*Method schedule. The function runs when the time advances us microseconds*/
+void VirtualClock::schedule(long us, std::function<void()> fn){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    Event event = {current + (us > 0 ? us : 0), seq++, nullptr, fn}; 
+    events.push(event); 
+}
+
+/*Method prepareWait. Ticket of the key to wait for it if the condition is still false*/
+long VirtualClock::prepareWait(const void *key){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return channels[key].generation; 
+}
+
+/*Method wait. The thread stops running until a notify() of the key after the ticket*/
+void VirtualClock::wait(const void *key, long ticket){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    Channel &channel = channels[key]; 
+    if(channel.generation != ticket){
+        return; 
+    }
+    channel.waiters++; 
+    active--; 
+    advance(ul); 
+    while(channel.generation == ticket){
+        channel.cv.wait(ul); 
+    }
+}
+
+/*Method notify. The threads waiting for the key run again*/
+void VirtualClock::notify(const void *key){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    Channel &channel = channels[key]; 
+    channel.generation++; 
+    if(channel.waiters > 0){
+        active          += channel.waiters; 
+        channel.waiters  = 0; 
+        channel.cv.notify_all(); 
+    }
+}
+
+/*Method getEvents. Events processed*/
+long VirtualClock::getEvents(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return num_events; 
+}
@@ -0,0 +1,104 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Coroutine.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the executor of the coroutines
+ * 
+ ******************************************************/
+#include <coroutine>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+#include "../include/Coroutine.h"
+
+Executor *Executor::current = nullptr; 
+
+/*Constructor. It is the executor of every awaitable, the timer thread is only needed in real time*/
+Executor::Executor(ThreadPool &p, Clock *c, VirtualClock *v, double s): pool(p), clock(c), virtual_clock(v), scale(s), seq(0), stopping(false){
+    current = this; 
+    if(virtual_clock == nullptr && scale > 0){
+        timer = std::thread(&Executor::runTimers, this); 
+    }
+}
+
+/*Destructor*/
+Executor::~Executor(){
+    stop(); 
+    if(current == this){
+        current = nullptr; 
+    }
+}
+
+/*Method get. Executor that resumes the coroutines of the queues and the semaphores*/
+Executor *Executor::get(){ return current; }
+
+/*Method spawn. The coroutine starts in a worker*/
+void Executor::spawn(Task task){
+    resume(task.handle); 
+}
+
+/*Method resume. The coroutine goes on in a worker. Until it suspends again it counts as a thread of the simulation*/
+void Executor::resume(std::coroutine_handle<> h){
+    clock->enter(); 
+    pool.submit([this, h](){
+        h.resume(); 
+        clock->leave(); 
+    }); 
+}
+
+/*Method wakeAfter. The coroutine is resumed after the delay, in virtual time by an event of the clock*/
+void Executor::wakeAfter(long us, std::coroutine_handle<> h){
+    if(virtual_clock != nullptr){
+        virtual_clock->schedule(us, [this, h](){ resume(h); }); 
+        return; 
+    }
+    long deadline = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+                  + static_cast<long>(us * scale); 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    timers.push({deadline, seq++, h}); 
+    cv_.notify_one(); 
+}
+
+/*Method sleepFor. co_await executor.sleepFor(us) is the delay of a service without a thread sleeping*/
+Executor::Sleep Executor::sleepFor(long us){ return Sleep{this, us}; }
+
+/*Method runTimers. Timer thread, it resumes the coroutines whose delay has ended*/
+void Executor::runTimers(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    while(!stopping){
+        if(timers.empty()){
+            cv_.wait(ul); 
+            continue; 
+        }
+        long now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); 
+        if(timers.top().deadline > now){
+            cv_.wait_for(ul, std::chrono::microseconds(timers.top().deadline - now)); 
+            continue; 
+        }
+        std::coroutine_handle<> h = timers.top().handle; 
+        timers.pop(); 
+        ul.unlock(); 
+        resume(h); 
+        ul.lock(); 
+    }
+}
+
+/*Method stop. It ends the timer thread, every delay has ended before*/
+void Executor::stop(){
+    if(!timer.joinable()){
+        return; 
+    }
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        stopping = true; 
+    }
+    cv_.notify_one(); 
+    timer.join(); 
+}
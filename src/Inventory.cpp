@@ -0,0 +1,226 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Inventory.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the inventory of seats of every showing
+ * 
+ ******************************************************/
+#include <vector>
+#include <mutex>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../include/Inventory.h"
+
+/*Constructor of showing*/
+Showing::Showing(int id, int hall, int rows, int cols): id(id), hall(hall), seats(rows, cols), held(0), available(rows * cols), sold(0){}
+
+/*Destructor*/
+Inventory::~Inventory(){
+    for(unsigned i = 0; i < showings.size(); i++){
+        delete showings[i]; 
+    }
+}
+
+/*Method get. Showing of the id, it throws if it doesn't exist*/
+Showing *Inventory::get(int showing){
+    if(showing < 1 || showing > static_cast<int>(showings.size())){
+        throw std::out_of_range("showing " + std::to_string(showing) + " doesn't exist"); 
+    }
+    return showings[showing - 1]; 
+}
+
+/*Method addShowing. It returns the id of the new showing*/
+int Inventory::addShowing(int hall, int rows, int cols){
+    showings.push_back(new Showing(showings.size() + 1, hall, rows, cols)); 
+    return showings.size(); 
+}
+
+/*Method take. It takes n seats from the available ones, false without changing them if there aren't enough*/
+bool Inventory::take(Showing *s, int n){
+    int available = s->available.load(std::memory_order_relaxed); 
+    while(available >= n){
+        if(s->available.compare_exchange_weak(available, available - n, std::memory_order_acquire, std::memory_order_relaxed)){
+            return true; 
+        }
+    }
+    return false; 
+}
+
+/*Method allocate. The seats are taken before the lock, so the map always has them*/
+bool Inventory::allocate(int showing, int n, std::vector<int> &seats){
+    Showing *s = get(showing); 
+    if(n <= 0 || !take(s, n)){
+        return false; 
+    }
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    s->seats.allocate(n, seats); 
+    s->sold += n; 
+    return true; 
+}
+
+/*Method release. The seats are available again after they are free in the map*/
+void Inventory::release(int showing, const std::vector<int> &seats){
+    Showing *s = get(showing); 
+    {
+        std::lock_guard<std::mutex> lg(s->mutex_); 
+        s->seats.release(seats); 
+        s->sold -= seats.size(); 
+    }
+    s->available.fetch_add(seats.size(), std::memory_order_release); 
+}
+
+/*Method hold. First phase of a sale, the seats are taken while the client pays*/
+bool Inventory::hold(int showing, int n, std::vector<int> &seats){
+    Showing *s = get(showing); 
+    if(n <= 0 || !take(s, n)){
+        return false; 
+    }
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    s->seats.allocate(n, seats); 
+    s->held += n; 
+    return true; 
+}
+
+/*Method confirm. The payment was approved so the held seats are sold*/
+void Inventory::confirm(int showing, const std::vector<int> &seats){
+    Showing *s = get(showing); 
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    s->held -= seats.size(); 
+    s->sold += seats.size(); 
+}
+
+/*Method releaseHold. The payment failed or was abandoned so the held seats are free again*/
+void Inventory::releaseHold(int showing, const std::vector<int> &seats){
+    Showing *s = get(showing); 
+    {
+        std::lock_guard<std::mutex> lg(s->mutex_); 
+        s->seats.release(seats); 
+        s->held -= seats.size(); 
+    }
+    s->available.fetch_add(seats.size(), std::memory_order_release); 
+}
+
+/*Method lockGroup. It locks each showing of the legs once and in increasing id*/
+void Inventory::lockGroup(const std::vector<BookingLeg> &legs, std::vector<std::unique_lock<std::mutex>> &locks){
+    std::vector<int> ids; 
+    for(unsigned i = 0; i < legs.size(); i++){
+        get(legs[i].showing); 
+        ids.push_back(legs[i].showing); 
+    }
+    std::sort(ids.begin(), ids.end()); 
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end()); 
+    for(unsigned i = 0; i < ids.size(); i++){
+        locks.emplace_back(showings[ids[i] - 1]->mutex_); 
+    }
+}
+
+/*Method holdGroup. It holds the seats of every leg or, if one leg doesn't fit, none*/
+bool Inventory::holdGroup(std::vector<BookingLeg> &legs){
+    std::vector<std::unique_lock<std::mutex>> locks; 
+    lockGroup(legs, locks); 
+    unsigned taken = 0; 
+    for(; taken < legs.size(); taken++){
+        legs[taken].seats.clear(); 
+        if(legs[taken].num_seats <= 0 || !take(showings[legs[taken].showing - 1], legs[taken].num_seats)){
+            break; 
+        }
+        showings[legs[taken].showing - 1]->seats.allocate(legs[taken].num_seats, legs[taken].seats); 
+    }
+    if(taken < legs.size()){ /*the legs already taken go back before anyone can see them*/
+        for(unsigned i = 0; i < taken; i++){
+            showings[legs[i].showing - 1]->seats.release(legs[i].seats); 
+            showings[legs[i].showing - 1]->available.fetch_add(legs[i].num_seats, std::memory_order_release); 
+            legs[i].seats.clear(); 
+        }
+        return false; 
+    }
+    for(unsigned i = 0; i < legs.size(); i++){
+        showings[legs[i].showing - 1]->held += legs[i].num_seats; 
+    }
+    return true; 
+}
+
+/*Method confirmGroup. The payment of the group was approved*/
+void Inventory::confirmGroup(const std::vector<BookingLeg> &legs){
+    std::vector<std::unique_lock<std::mutex>> locks; 
+    lockGroup(legs, locks); 
+    for(unsigned i = 0; i < legs.size(); i++){
+        showings[legs[i].showing - 1]->held -= legs[i].seats.size(); 
+        showings[legs[i].showing - 1]->sold += legs[i].seats.size(); 
+    }
+}
+
+/*Method releaseGroupHold. The payment of the group failed or was abandoned*/
+void Inventory::releaseGroupHold(const std::vector<BookingLeg> &legs){
+    std::vector<std::unique_lock<std::mutex>> locks; 
+    lockGroup(legs, locks); 
+    for(unsigned i = 0; i < legs.size(); i++){
+        showings[legs[i].showing - 1]->seats.release(legs[i].seats); 
+        showings[legs[i].showing - 1]->held -= legs[i].seats.size(); 
+        showings[legs[i].showing - 1]->available.fetch_add(legs[i].seats.size(), std::memory_order_release); 
+    }
+}
+
+/*Method restore. The seat was sold before the restart, it is taken without hold*/
+bool Inventory::restore(int showing, int seat){
+    Showing *s = get(showing); 
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    if(seat < 0 || seat >= s->seats.getCapacity() || !s->seats.allocateSeat(seat)){
+        return false; 
+    }
+    s->available--; /*before the sales start*/
+    s->sold++; 
+    return true; 
+}
+
+/*Method getHeld*/
+int Inventory::getHeld(int showing){
+    Showing *s = get(showing); 
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    return s->held; 
+}
+
+/*Method getFree*/
+int Inventory::getFree(int showing){
+    Showing *s = get(showing); 
+    std::lock_guard<std::mutex> lg(s->mutex_); 
+    return s->seats.getFree(); 
+}
+
+/*Method getAvailable. Free seats without the lock, a sale may be choosing them*/
+int Inventory::getAvailable(int showing){ return get(showing)->available.load(std::memory_order_relaxed); }
+
+/*Method getRemaining. Seats free or held, the ones that may still be sold*/
+int Inventory::getRemaining(int showing){
+    Showing *s = get(showing); 
+    return s->seats.getCapacity() - s->sold.load(std::memory_order_acquire); 
+}
+
+/*Method getCapacity*/
+int Inventory::getCapacity(int showing){ return get(showing)->seats.getCapacity(); }
+
+/*Method getHall*/
+int Inventory::getHall(int showing){ return get(showing)->hall; }
+
+/*Method getNumShowings*/
+int Inventory::getNumShowings(){ return showings.size(); }
+
+/*Method getSold. Seats sold in every showing, the held ones aren't sold yet*/
+int Inventory::getSold(){
+    int sold = 0; 
+    for(unsigned i = 0; i < showings.size(); i++){
+        std::lock_guard<std::mutex> lg(showings[i]->mutex_); 
+        sold += showings[i]->seats.getCapacity() - showings[i]->seats.getFree() - showings[i]->held; 
+    }
+    return sold; 
+}
+
+/*Method seatName*/
+std::string Inventory::seatName(int showing, int seat){ return get(showing)->seats.seatName(seat); }
@@ -0,0 +1,435 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Journal.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the journal of the sales
+ * 
+ ******************************************************/
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../include/Journal.h"
+
+/*Constructor of the state, nothing sold*/
+JournalState::JournalState(): lsn(0), approved(0), rejected(0), refunded(0){}
+
+/*Method apply. It adds the change of the record to the state*/
+void JournalState::apply(const JournalRecord &record){
+    switch(record.type){
+        case J_SEAT_SOLD:
+            if(static_cast<int>(seats.size()) < record.args[0]){
+                seats.resize(record.args[0]); 
+            }
+            if(static_cast<int>(seats[record.args[0] - 1].size()) <= record.args[1]){
+                seats[record.args[0] - 1].resize(record.args[1] + 1, 0); 
+            }
+            seats[record.args[0] - 1][record.args[1]] = 1; 
+            break; 
+        case J_STOCK:
+            if(static_cast<int>(drinks.size()) < record.args[0]){
+                drinks.resize(record.args[0], 0); 
+                popcorn.resize(record.args[0], 0); 
+            }
+            drinks[record.args[0] - 1]  += record.args[1]; 
+            popcorn[record.args[0] - 1] += record.args[2]; 
+            break; 
+        case J_PAYMENT:
+            if(record.args[2] == J_PAY_APPROVED){
+                approved++; 
+            }else if(record.args[2] == J_PAY_REFUNDED){
+                refunded++; 
+            }else{
+                rejected++; 
+            }
+            break; 
+    }
+    lsn = record.lsn; 
+}
+
+/*Method getSold. Seats sold in every showing*/
+long JournalState::getSold(){
+    long sold = 0; 
+    for(unsigned i = 0; i < seats.size(); i++){
+        for(unsigned j = 0; j < seats[i].size(); j++){
+            sold += seats[i][j]; 
+        }
+    }
+    return sold; 
+}
+
+/*Constructor*/
+Journal::Journal(): fd(-1), base(nullptr), size(0), page(4096), durability(JOURNAL_GROUP), window_us(0), snapshot_every(0),
+                    written(0), durable(0), commits(0), syncs(0), snapshots(0), stopping(false){}
+
+/*Destructor*/
+Journal::~Journal(){
+    close(); 
+}
+
+/*Method offset. Position of the record in the file*/
+long Journal::offset(unsigned long lsn){
+    return JOURNAL_HEADER + static_cast<long>(lsn - 1) * sizeof(JournalRecord); 
+}
+
+/*Method checksum. FNV-1a of the record without the checksum*/
+unsigned Journal::checksum(const JournalRecord &record){
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(&record); 
+    unsigned hash = 2166136261u; 
+    for(unsigned i = 0; i < offsetof(JournalRecord, checksum); i++){
+        hash = (hash ^ bytes[i]) * 16777619u; 
+    }
+    return hash; 
+}
+
+/*Method replay. It applies the complete transactions with the next sequence numbers and stops
+  at the first record that is torn, empty or out of order. It returns the last lsn applied*/
+unsigned long Journal::replay(const char *records, long bytes, JournalState &state){
+    const JournalRecord *r = reinterpret_cast<const JournalRecord*>(records); 
+    long count = bytes / static_cast<long>(sizeof(JournalRecord)); 
+    long i     = 0; 
+    while(i < count){
+        unsigned long lsn = state.lsn + 1; 
+        int left          = r[i].left; 
+        bool complete     = left >= 0 && i + left < count; 
+        for(int k = 0; complete && k <= left; k++){
+            const JournalRecord &record = r[i + k]; 
+            complete = record.lsn == lsn + k && record.left == left - k && record.checksum == checksum(record); 
+        }
+        if(!complete){
+            break; 
+        }
+        for(int k = 0; k <= left; k++){
+            state.apply(r[i + k]); 
+        }
+        i += left + 1; 
+    }
+    return state.lsn; 
+}
+
+/*Method readSnapshot. State saved by writeSnapshot, false if there isn't a valid one*/
+bool Journal::readSnapshot(std::string file, JournalState &state){
+    FILE *in = std::fopen(file.c_str(), "rb"); 
+    if(in == nullptr){
+        return false; 
+    }
+    char magic[8]; 
+    JournalState s; 
+    unsigned long showings = 0, points = 0; 
+    bool ok = std::fread(magic, 1, sizeof(magic), in) == sizeof(magic) && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0
+           && std::fread(&s.lsn, sizeof(s.lsn), 1, in) == 1 && std::fread(&s.approved, sizeof(s.approved), 1, in) == 1
+           && std::fread(&s.rejected, sizeof(s.rejected), 1, in) == 1 && std::fread(&s.refunded, sizeof(s.refunded), 1, in) == 1
+           && std::fread(&showings, sizeof(showings), 1, in) == 1; 
+    for(unsigned long i = 0; ok && i < showings; i++){
+        unsigned long n = 0; 
+        ok = std::fread(&n, sizeof(n), 1, in) == 1; 
+        if(ok){
+            s.seats.push_back(std::vector<char>(n)); 
+            ok = n == 0 || std::fread(s.seats.back().data(), 1, n, in) == n; 
+        }
+    }
+    ok = ok && std::fread(&points, sizeof(points), 1, in) == 1; 
+    if(ok){
+        s.drinks.resize(points); 
+        s.popcorn.resize(points); 
+        ok = points == 0 || (std::fread(s.drinks.data(), sizeof(long), points, in) == points
+                          && std::fread(s.popcorn.data(), sizeof(long), points, in) == points); 
+    }
+    std::fclose(in); 
+    if(ok){
+        state = s; 
+    }
+    return ok; 
+}
+
+/*Method writeSnapshot. It adds the records after the last snapshot to its state and writes it. The file is
+  written aside and renamed so a crash in the middle leaves the previous one*/
+void Journal::writeSnapshot(unsigned long lsn){
+    replay(base + offset(snapshot.lsn + 1), offset(lsn + 1) - offset(snapshot.lsn + 1), snapshot); 
+
+    std::string tmp = file + ".snap.tmp"; 
+    FILE *out = std::fopen(tmp.c_str(), "wb"); 
+    if(out == nullptr){
+        return; 
+    }
+    unsigned long showings = snapshot.seats.size(), points = snapshot.drinks.size(); 
+    std::fwrite(SNAPSHOT_MAGIC, 1, 8, out); 
+    std::fwrite(&snapshot.lsn, sizeof(snapshot.lsn), 1, out); 
+    std::fwrite(&snapshot.approved, sizeof(snapshot.approved), 1, out); 
+    std::fwrite(&snapshot.rejected, sizeof(snapshot.rejected), 1, out); 
+    std::fwrite(&snapshot.refunded, sizeof(snapshot.refunded), 1, out); 
+    std::fwrite(&showings, sizeof(showings), 1, out); 
+    for(unsigned long i = 0; i < showings; i++){
+        unsigned long n = snapshot.seats[i].size(); 
+        std::fwrite(&n, sizeof(n), 1, out); 
+        std::fwrite(snapshot.seats[i].data(), 1, n, out); 
+    }
+    std::fwrite(&points, sizeof(points), 1, out); 
+    std::fwrite(snapshot.drinks.data(), sizeof(long), points, out); 
+    std::fwrite(snapshot.popcorn.data(), sizeof(long), points, out); 
+    std::fflush(out); 
+    fsync(fileno(out)); 
+    std::fclose(out); 
+    std::rename(tmp.c_str(), (file + ".snap").c_str()); 
+    snapshots++; 
+}
+
+/*Method recover. State of the last snapshot plus the complete transactions of the journal after it.
+  It returns false if the file isn't a journal*/
+bool Journal::recover(std::string file, JournalState &state){
+    state = JournalState(); 
+    readSnapshot(file + ".snap", state); 
+
+    int in = ::open(file.c_str(), O_RDONLY); 
+    if(in < 0){
+        return true;    /*no journal yet*/
+    }
+    struct stat st; 
+    if(fstat(in, &st) != 0){
+        st.st_size = 0; 
+    }
+    if(st.st_size < JOURNAL_HEADER){
+        ::close(in); 
+        return st.st_size == 0;     /*an empty file is a new journal*/
+    }
+    char *data = static_cast<char*>(mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, in, 0)); 
+    ::close(in); 
+    if(data == MAP_FAILED){
+        return false; 
+    }
+    int record_size = 0; 
+    std::memcpy(&record_size, data + 8, sizeof(record_size)); 
+    bool ok = std::memcmp(data, JOURNAL_MAGIC, 8) == 0 && record_size == sizeof(JournalRecord); 
+    long start = JOURNAL_HEADER + static_cast<long>(state.lsn) * sizeof(JournalRecord); 
+    if(ok && start < st.st_size){
+        madvise(data + start, st.st_size - start, MADV_SEQUENTIAL); 
+        replay(data + start, st.st_size - start, state); 
+    }
+    munmap(data, st.st_size); 
+    return ok; 
+}
+
+/*Method open. It recovers the state of the file and opens it to add the next records after the last
+  complete transaction. With durability JOURNAL_GROUP the flusher waits window_us for more commits
+  before each sync, and it writes a snapshot every snapshot_every records*/
+bool Journal::open(std::string f, int d, long window, long every, JournalState &state){
+    if(base != nullptr || !recover(f, state)){
+        return false; 
+    }
+    fd = ::open(f.c_str(), O_RDWR | O_CREAT, 0644); 
+    if(fd < 0){
+        return false; 
+    }
+    file           = f; 
+    durability     = d; 
+    window_us      = window; 
+    snapshot_every = every; 
+    page           = sysconf(_SC_PAGESIZE); 
+    snapshot       = state; 
+    written        = state.lsn; 
+    durable        = state.lsn; 
+
+    /*The records after the last complete transaction are cut, a later recovery can't find them after the new ones*/
+    long end = offset(written + 1); 
+    size     = (end / JOURNAL_CHUNK + 1) * JOURNAL_CHUNK; 
+    if(ftruncate(fd, end) != 0 || ftruncate(fd, size) != 0){
+        ::close(fd); 
+        fd = -1; 
+        return false; 
+    }
+    void *mapping = mmap(nullptr, JOURNAL_MAX_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0); 
+    if(mapping == MAP_FAILED){
+        ::close(fd); 
+        fd = -1; 
+        return false; 
+    }
+    base = static_cast<char*>(mapping); 
+    int record_size = sizeof(JournalRecord); 
+    std::memcpy(base, JOURNAL_MAGIC, 8); 
+    std::memcpy(base + 8, &record_size, sizeof(record_size)); 
+    msync(base, page, MS_SYNC); 
+    fsync(fd); 
+
+    stopping = false; 
+    flusher  = std::thread(&Journal::flush, this); 
+    return true; 
+}
+
+/*Method sync. It writes to the disk the pages of the records from one lsn to another*/
+void Journal::sync(unsigned long from, unsigned long to){
+    long start = offset(from) / page * page; 
+    msync(base + start, offset(to + 1) - start, MS_SYNC); 
+    syncs++; 
+}
+
+/*Method append. It copies the records at the end of the file as one transaction and returns the lsn of the 
+  last one. The lsn, left and checksum of the records are filled here. In group mode the function, if there is 
+  one, waits for the flusher in the same order as the records*/
+unsigned long Journal::append(JournalRecord *records, int n, std::function<void()> *on_durable){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    unsigned long first = written + 1; 
+    unsigned long last  = written + n; 
+    if(offset(last + 1) > size){
+        if(size + JOURNAL_CHUNK > JOURNAL_MAX_SIZE || ftruncate(fd, size + JOURNAL_CHUNK) != 0){
+            throw std::length_error("the journal " + file + " is full"); 
+        }
+        size += JOURNAL_CHUNK; 
+    }
+    for(int i = 0; i < n; i++){
+        records[i].lsn      = first + i; 
+        records[i].left     = n - 1 - i; 
+        records[i].checksum = checksum(records[i]); 
+    }
+    std::memcpy(base + offset(first), records, n * sizeof(JournalRecord)); 
+    written = last; 
+    if(on_durable != nullptr && durability == JOURNAL_GROUP){
+        waiting.push_back({last, std::move(*on_durable)}); 
+    }
+    commits++; 
+    return last; 
+}
+
+/*Method commit. It adds the records as one transaction and returns the lsn of the last one when they
+  are as durable as the mode says*/
+unsigned long Journal::commit(JournalRecord *records, int n){
+    if(base == nullptr || n <= 0){
+        return 0; 
+    }
+    unsigned long last  = append(records, n, nullptr); 
+    unsigned long first = last - n + 1; 
+
+    if(durability == JOURNAL_SYNC){
+        sync(first, last); 
+        if(snapshot_every > 0 && last % snapshot_every < static_cast<unsigned long>(n)){
+            work_.notify_one();     /*only for the snapshot*/
+        }
+        return last; 
+    }
+    work_.notify_one(); 
+    if(durability == JOURNAL_GROUP){
+        std::unique_lock<std::mutex> ul(mutex_); 
+        done_.wait(ul, [this, last](){ return durable >= last; }); 
+    }
+    return last; 
+}
+
+/*Method commit. The same commit but the caller doesn't wait: the function is called when the records are as 
+  durable as the mode says, in group mode by the flusher after the sync that has them*/
+void Journal::commit(JournalRecord *records, int n, std::function<void()> on_durable){
+    if(base == nullptr || n <= 0){
+        on_durable(); 
+        return; 
+    }
+    if(durability != JOURNAL_GROUP){
+        commit(records, n); 
+        on_durable(); 
+        return; 
+    }
+    append(records, n, &on_durable); 
+    work_.notify_one(); 
+}
+
+/*Method flush. Background thread that syncs at once every record copied since the last sync
+  and wakes their commits. It writes the snapshots too, so the commits never wait for them*/
+void Journal::flush(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    while(true){
+        work_.wait(ul, [this](){ return stopping || written > durable; }); 
+        if(written == durable){
+            break;  /*stopping*/
+        }
+        if(window_us > 0 && !stopping){
+            ul.unlock(); 
+            std::this_thread::sleep_for(std::chrono::microseconds(window_us));  /*more commits join the group*/
+            ul.lock(); 
+        }
+        unsigned long from = durable + 1; 
+        unsigned long to   = written; 
+        ul.unlock(); 
+        if(durability != JOURNAL_SYNC){
+            sync(from, to); 
+        }
+        if(snapshot_every > 0 && to - snapshot.lsn >= static_cast<unsigned long>(snapshot_every)){
+            writeSnapshot(to); 
+        }
+        ul.lock(); 
+        durable = to; 
+        done_.notify_all(); 
+
+        /*The functions of the commits synced, in order. They run without the lock, they can commit again*/
+        std::vector<std::pair<unsigned long, std::function<void()>>> ready; 
+        unsigned k = 0; 
+        while(k < waiting.size() && waiting[k].first <= to){
+            k++; 
+        }
+        ready.assign(std::make_move_iterator(waiting.begin()), std::make_move_iterator(waiting.begin() + k)); 
+        waiting.erase(waiting.begin(), waiting.begin() + k); 
+        if(!ready.empty()){
+            ul.unlock(); 
+            for(unsigned i = 0; i < ready.size(); i++){
+                ready[i].second(); 
+            }
+            ul.lock(); 
+        }
+    }
+}
+
+/*Method close. It syncs the last records and cuts the file at the end of them*/
+void Journal::close(){
+    if(base == nullptr){
+        return; 
+    }
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        stopping = true; 
+    }
+    work_.notify_one(); 
+    flusher.join(); 
+    munmap(base, JOURNAL_MAX_SIZE); 
+    base = nullptr; 
+    if(ftruncate(fd, offset(written + 1)) == 0){
+        fsync(fd); 
+    }
+    ::close(fd); 
+    fd = -1; 
+}
+
+/*Method syncFile. It writes every page of the file without locks, so it can be called from a signal handler*/
+void Journal::syncFile(){
+    if(fd >= 0){
+        fsync(fd); 
+    }
+}
+
+/*Method isOpen*/
+bool Journal::isOpen(){ return base != nullptr; }
+
+/*Method getCommits*/
+long Journal::getCommits(){ return commits; }
+
+/*Method getSyncs. Syncs of the records, the commits of a group share one*/
+long Journal::getSyncs(){ return syncs; }
+
+/*Method getSnapshots*/
+long Journal::getSnapshots(){ return snapshots; }
+
+/*Method getRecords*/
+unsigned long Journal::getRecords(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return written; 
+}
@@ -0,0 +1,80 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    LatencyStats.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the latencies of a phase of the simulation
+ * 
+ ******************************************************/
+#include <atomic>
+#include <string>
+#include <algorithm>
+
+#include "../include/LatencyStats.h"
+
+/*Constructor*/
+LatencyStats::LatencyStats(std::string n): name(n), max_us(0){
+    for(int b = 0; b < LATENCY_BUCKETS; b++){
+        buckets[b].store(0, std::memory_order_relaxed); 
+    }
+}
+
+/*Method record. The latency goes to the bucket of its number of bits*/
+void LatencyStats::record(long us){
+    if(us < 0){
+        us = 0; 
+    }
+    int bucket = us == 0 ? 0 : 64 - __builtin_clzl(us); 
+    if(bucket >= LATENCY_BUCKETS){
+        bucket = LATENCY_BUCKETS - 1; 
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed); 
+    long longest = max_us.load(std::memory_order_relaxed); 
+    while(us > longest && !max_us.compare_exchange_weak(longest, us, std::memory_order_relaxed)){}
+}
+
+/*Method getName*/
+std::string LatencyStats::getName(){ return name; }
+
+/*Method getCount*/
+long LatencyStats::getCount(){
+    long total = 0; 
+    for(int b = 0; b < LATENCY_BUCKETS; b++){
+        total += buckets[b].load(std::memory_order_relaxed); 
+    }
+    return total; 
+}
+
+/*Method getPercentile. Latency of the percentile p (0-100) interpolated inside its bucket and never above 
+  the maximum, 0 if there are no samples*/
+long LatencyStats::getPercentile(double p){
+    long counts[LATENCY_BUCKETS]; 
+    long total = 0; 
+    for(int b = 0; b < LATENCY_BUCKETS; b++){
+        counts[b] = buckets[b].load(std::memory_order_relaxed); 
+        total    += counts[b]; 
+    }
+    if(total == 0){
+        return 0; 
+    }
+    long longest = getMax(); 
+    long index   = static_cast<long>(p / 100.0 * (total - 1)); 
+    long before  = 0; 
+    for(int b = 0; b < LATENCY_BUCKETS; b++){
+        if(before + counts[b] > index){
+            long low  = b == 0 ? 0 : 1L << (b - 1); 
+            long high = b == 0 ? 0 : (1L << b) - 1; 
+            long us   = low + static_cast<long>((high - low) * ((index - before) + 0.5) / counts[b]); 
+            return std::min(us, longest); 
+        }
+        before += counts[b]; 
+    }
+    return longest; 
+}
+
+/*Method getMax*/
+long LatencyStats::getMax(){ return max_us.load(std::memory_order_relaxed); }
@@ -0,0 +1,296 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Ledger.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the ledger of the sales and its queries
+ * 
+ ******************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#include "../include/Ledger.h"
+
+/*Selection of the rows of the filter, -1 if the row is selected and 0 if not, and key of each row in the column.
+  With FULL the loops have a fixed number of rows and the compiler vectorizes them*/
+template <bool FULL>
+static void selectRows(const unsigned *time, const unsigned char *type, const unsigned short *point, const unsigned short *showing,
+                       const unsigned char *basket, int rows, bool all, const LedgerFilter &filter, int column, int *sel, unsigned *key){
+    int n = FULL ? LEDGER_BATCH : rows; 
+    if(all){
+        for(int i = 0; i < n; i++){
+            sel[i] = -1; 
+        }
+    }else{
+        int      any  = filter.type == 0; 
+        int      t    = filter.type; 
+        unsigned from = filter.from, to = filter.to; 
+        for(int i = 0; i < n; i++){
+            sel[i] = -((any | (type[i] == t)) & (time[i] >= from) & (time[i] < to)); 
+        }
+    }
+    switch(column){
+        case LEDGER_SALE_POINT:
+            for(int i = 0; i < n; i++){
+                key[i] = point[i]; 
+            }
+            break; 
+        case LEDGER_MINUTE:
+            for(int i = 0; i < n; i++){
+                key[i] = time[i] / 60; 
+            }
+            break; 
+        case LEDGER_SHOWING:
+            for(int i = 0; i < n; i++){
+                key[i] = showing[i]; 
+            }
+            break; 
+        case LEDGER_BASKET:
+            for(int i = 0; i < n; i++){
+                key[i] = basket[i]; 
+            }
+            break; 
+    }
+}
+
+/*Sums of the selected rows. A group by adds each row to one of four copies of the sums, in turns, so the rows
+  of the same key in a row don't wait for each other*/
+template <bool FULL>
+static void sumRows(const int *amount, const int *sel, const unsigned *key, int rows, int column, long keys, long *count, long *revenue){
+    int n = FULL ? LEDGER_BATCH : rows; 
+    if(column == LEDGER_TOTAL){
+        long c = 0, r = 0; 
+        for(int i = 0; i < n; i++){
+            c -= sel[i]; 
+            r += amount[i] & sel[i]; 
+        }
+        count[0]   += c; 
+        revenue[0] += r; 
+        return; 
+    }
+    for(int i = 0; i < n; i++){
+        long slot = (i & 3) * keys + key[i]; 
+        count[slot]   -= sel[i]; 
+        revenue[slot] += amount[i] & sel[i]; 
+    }
+}
+
+/*Constructor of a ring*/
+Ledger::Ring::Ring(): head(0), tail(0){}
+
+/*Constructor. Until start is called the rows are moved to the chunks only when a ring is full or with flush*/
+Ledger::Ledger(): chunks(new std::atomic<Chunk*>[LEDGER_MAX_CHUNKS]), published(0), stored(0), dropped(0), stopping(false){
+    for(long c = 0; c < LEDGER_MAX_CHUNKS; c++){
+        chunks[c].store(nullptr, std::memory_order_relaxed); 
+    }
+    for(int k = 0; k < LEDGER_KEYS; k++){
+        max_key[k].store(0, std::memory_order_relaxed); 
+    }
+}
+
+/*Destructor*/
+Ledger::~Ledger(){
+    stop(); 
+    for(long c = 0; c < LEDGER_MAX_CHUNKS; c++){
+        delete chunks[c].load(); 
+    }
+    delete[] chunks; 
+    for(unsigned i = 0; i < rings.size(); i++){
+        delete rings[i]; 
+    }
+}
+
+/*Method ring. Ring of the thread, it is created the first time the thread appends*/
+Ledger::Ring *Ledger::ring(){
+    Ring *local = locals.get(); 
+    if(local == nullptr){
+        local = new Ring; 
+        locals.set(local); 
+        std::lock_guard<std::mutex> lg(mutex_); 
+        rings.push_back(local); 
+    }
+    return local; 
+}
+
+/*Method append. The sale is written in the ring of the thread, if the ring is full the thread moves the rows*/
+void Ledger::append(unsigned time, int type, int point, int showing, int basket, int amount){
+    Ring *r = ring(); 
+    unsigned long tail = r->tail.load(std::memory_order_relaxed); 
+    while(tail - r->head.load(std::memory_order_acquire) >= LEDGER_RING_SIZE){
+        flush(); 
+    }
+    LedgerRow &row = r->rows[tail & (LEDGER_RING_SIZE - 1)]; 
+    row.time    = time; 
+    row.amount  = amount; 
+    row.point   = point; 
+    row.showing = showing; 
+    row.basket  = std::min(basket, 255); 
+    row.type    = type; 
+    r->tail.store(tail + 1, std::memory_order_release); 
+    if(tail - r->head.load(std::memory_order_relaxed) == LEDGER_RING_SIZE / 2){
+        cv_.notify_one(); /*the writer doesn't wait for the end of the period*/
+    }
+}
+
+/*Method store. It writes the row at the end of the chunks, with mutex_move locked*/
+void Ledger::store(const LedgerRow &row){
+    long c = stored / LEDGER_CHUNK_ROWS; 
+    long i = stored % LEDGER_CHUNK_ROWS; 
+    if(c >= LEDGER_MAX_CHUNKS){
+        dropped++; 
+        return; 
+    }
+    Chunk *chunk = chunks[c].load(std::memory_order_relaxed); 
+    if(i == 0){
+        chunk = new Chunk; 
+        chunk->min_time = row.time; 
+        chunk->max_time = row.time; 
+        chunks[c].store(chunk, std::memory_order_release); 
+    }
+    chunk->time[i]    = row.time; 
+    chunk->amount[i]  = row.amount; 
+    chunk->point[i]   = row.point; 
+    chunk->showing[i] = row.showing; 
+    chunk->basket[i]  = row.basket; 
+    chunk->type[i]    = row.type; 
+    chunk->min_time   = std::min(chunk->min_time, row.time); 
+    chunk->max_time   = std::max(chunk->max_time, row.time); 
+    long keys[LEDGER_KEYS] = {row.point, row.time / 60, row.showing, row.basket}; 
+    for(int k = 0; k < LEDGER_KEYS; k++){
+        if(keys[k] > max_key[k].load(std::memory_order_relaxed)){
+            max_key[k].store(keys[k], std::memory_order_relaxed); 
+        }
+    }
+    stored++; 
+}
+
+/*Method flush. It moves the rows of every ring to the chunks and publishes them*/
+void Ledger::flush(){
+    std::lock_guard<std::mutex> lg(mutex_move); 
+    std::vector<Ring*> current; 
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        current = rings; 
+    }
+    for(unsigned r = 0; r < current.size(); r++){
+        unsigned long head = current[r]->head.load(std::memory_order_relaxed); 
+        unsigned long tail = current[r]->tail.load(std::memory_order_acquire); 
+        for(; head != tail; head++){
+            store(current[r]->rows[head & (LEDGER_RING_SIZE - 1)]); 
+        }
+        current[r]->head.store(head, std::memory_order_release); 
+    }
+    published.store(stored, std::memory_order_release); 
+}
+
+/*Method write. Loop of the writer*/
+void Ledger::write(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    while(!stopping){
+        cv_.wait_for(ul, std::chrono::milliseconds(LEDGER_FLUSH_MS), [this](){ return stopping; }); 
+        ul.unlock(); 
+        flush(); 
+        ul.lock(); 
+    }
+}
+
+/*Method start. It starts the writer*/
+void Ledger::start(){
+    if(writer.joinable()){
+        return; 
+    }
+    stopping = false; 
+    writer   = std::thread(&Ledger::write, this); 
+}
+
+/*Method stop. It ends the writer, every row appended before is published*/
+void Ledger::stop(){
+    if(writer.joinable()){
+        {
+            std::lock_guard<std::mutex> lg(mutex_); 
+            stopping = true; 
+        }
+        cv_.notify_one(); 
+        writer.join(); 
+    }
+    flush(); 
+}
+
+/*Method scan. Counts and sums of the first n rows in the groups of the column, four copies of keys groups each one*/
+void Ledger::scan(int column, const LedgerFilter &filter, long n, long keys, long *count, long *revenue){
+    bool unbounded = filter.type == 0 && filter.from == 0 && filter.to == UINT_MAX; 
+    int      sel[LEDGER_BATCH]; 
+    unsigned key[LEDGER_BATCH]; 
+    for(long c = 0; c * LEDGER_CHUNK_ROWS < n; c++){
+        Chunk *chunk = chunks[c].load(std::memory_order_acquire); 
+        long   rows  = std::min<long>(LEDGER_CHUNK_ROWS, n - c * LEDGER_CHUNK_ROWS); 
+        bool   full  = rows == LEDGER_CHUNK_ROWS; 
+        if(full && (chunk->max_time < filter.from || chunk->min_time >= filter.to)){
+            continue; 
+        }
+        bool all = unbounded || (full && filter.type == 0 && chunk->min_time >= filter.from && chunk->max_time < filter.to); 
+        for(long base = 0; base < rows; base += LEDGER_BATCH){
+            int b = std::min<long>(LEDGER_BATCH, rows - base); 
+            if(b == LEDGER_BATCH){
+                selectRows<true>(chunk->time + base, chunk->type + base, chunk->point + base, chunk->showing + base,
+                                 chunk->basket + base, b, all, filter, column, sel, key); 
+                sumRows<true>(chunk->amount + base, sel, key, b, column, keys, count, revenue); 
+            }else{
+                selectRows<false>(chunk->time + base, chunk->type + base, chunk->point + base, chunk->showing + base,
+                                  chunk->basket + base, b, all, filter, column, sel, key); 
+                sumRows<false>(chunk->amount + base, sel, key, b, column, keys, count, revenue); 
+            }
+        }
+    }
+}
+
+/*Method revenue. Cents of the rows of the filter*/
+long Ledger::revenue(const LedgerFilter &filter){
+    long count = 0, cents = 0; 
+    scan(LEDGER_TOTAL, filter, published.load(std::memory_order_acquire), 1, &count, &cents); 
+    return cents; 
+}
+
+/*Method groupBy. Rows and revenue of each key of the column with some row of the filter, ordered by key.
+  The keys are read after the rows, so they are never smaller than the keys of those rows*/
+std::vector<LedgerGroup> Ledger::groupBy(int column, const LedgerFilter &filter){
+    std::vector<LedgerGroup> groups; 
+    if(column < 0 || column >= LEDGER_KEYS){
+        return groups; 
+    }
+    long n    = published.load(std::memory_order_acquire); 
+    long keys = max_key[column].load(std::memory_order_relaxed) + 1; 
+    std::vector<long> count(4 * keys, 0), cents(4 * keys, 0); 
+    scan(column, filter, n, keys, count.data(), cents.data()); 
+    for(long k = 0; k < keys; k++){
+        LedgerGroup group = {k, 0, 0}; 
+        for(int copy = 0; copy < 4; copy++){
+            group.rows    += count[copy * keys + k]; 
+            group.revenue += cents[copy * keys + k]; 
+        }
+        if(group.rows > 0){
+            groups.push_back(group); 
+        }
+    }
+    return groups; 
+}
+
+/*Method getRows. Rows the queries can read*/
+long Ledger::getRows(){ return published.load(std::memory_order_acquire); }
+
+/*Method getDropped*/
+long Ledger::getDropped(){
+    std::lock_guard<std::mutex> lg(mutex_move); 
+    return dropped; 
+}
+
+/*Method getBytes. Memory of the chunks*/
+long Ledger::getBytes(){
+    long n = published.load(std::memory_order_acquire); 
+    return (n + LEDGER_CHUNK_ROWS - 1) / LEDGER_CHUNK_ROWS * static_cast<long>(sizeof(Chunk)); 
+}
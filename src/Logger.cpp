@@ -0,0 +1,203 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Logger.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the asynchronous logger of the system
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+#include "../include/color.h"
+#include "../include/Logger.h"
+
+/*Constructor of a ring*/
+Logger::Ring::Ring(): head(0), tail(0){}
+
+/*Constructor. Until start is called the lines are written as before, to std::cout*/
+Logger::Logger(const LogEvent *e): events(e), level(LOG_DEBUG), mode(LOG_SYNC), out(nullptr), stopping(false){}
+
+/*Destructor*/
+Logger::~Logger(){
+    stop(); 
+    for(unsigned i = 0; i < rings.size(); i++){
+        delete rings[i]; 
+    }
+}
+
+/*Method ring. Ring of the thread, it is created the first time the thread logs*/
+Logger::Ring *Logger::ring(){
+    thread_local Logger *owner = nullptr; 
+    thread_local Ring   *local = nullptr; 
+    if(owner != this){
+        local = new Ring; 
+        owner = this; 
+        std::lock_guard<std::mutex> lg(mutex_); 
+        rings.push_back(local); 
+    }
+    return local; 
+}
+
+/*Method add. It fills the record in the ring of the thread, if the ring is full it waits for the writer*/
+void Logger::add(int lvl, int event, const char *text, long a, long b, long c, long d){
+    if(mode == LOG_SYNC){
+        LogRecord record = {0, event, lvl, {a, b, c, d}, {0}}; 
+        if(text != nullptr){
+            std::strncpy(record.text, text, LOG_TEXT_SIZE - 1); 
+        }
+        std::cout << format(events, record) << std::endl; 
+        return; 
+    }
+
+    Ring *r = ring(); 
+    unsigned long tail = r->tail.load(std::memory_order_relaxed); 
+    while(tail - r->head.load(std::memory_order_acquire) >= LOG_RING_SIZE){
+        cv_.notify_one(); 
+        std::this_thread::yield(); 
+    }
+    LogRecord &record = r->records[tail & (LOG_RING_SIZE - 1)]; 
+    record.time    = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); 
+    record.event   = event; 
+    record.level   = lvl; 
+    record.args[0] = a; 
+    record.args[1] = b; 
+    record.args[2] = c; 
+    record.args[3] = d; 
+    record.text[0] = '\0'; 
+    if(text != nullptr){
+        std::strncpy(record.text, text, LOG_TEXT_SIZE - 1); 
+        record.text[LOG_TEXT_SIZE - 1] = '\0'; 
+    }
+    r->tail.store(tail + 1, std::memory_order_release); 
+    if(tail - r->head.load(std::memory_order_relaxed) == LOG_RING_SIZE / 2){
+        cv_.notify_one(); /*the writer doesn't wait for the end of the period*/
+    }
+}
+
+/*Method format. Line of the record with its color*/
+std::string Logger::format(const LogEvent *events, const LogRecord &record){
+    const LogEvent &event = events[record.event]; 
+    std::string line = event.color; 
+    int arg = 0; 
+    for(const char *f = event.format; *f != '\0'; f++){
+        if(f[0] == '{' && f[1] == '}'){
+            line += std::to_string(arg < LOG_MAX_ARGS ? record.args[arg] : 0); 
+            arg++; 
+            f++; 
+        }else if(f[0] == '{' && f[1] == 's' && f[2] == '}'){
+            line += record.text; 
+            f += 2; 
+        }else{
+            line += *f; 
+        }
+    }
+    line += RESET; 
+    return line; 
+}
+
+/*Method flush. It takes the records of every ring and writes the older ones than the start of the batch,
+  the rest wait for the next batch so the lines of different threads keep their order. At the end all are written*/
+void Logger::flush(bool all){
+    long cutoff = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); 
+    std::vector<Ring*> current; 
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        current = rings; 
+    }
+    for(unsigned i = 0; i < current.size(); i++){
+        Ring *r = current[i]; 
+        unsigned long head = r->head.load(std::memory_order_relaxed); 
+        unsigned long tail = r->tail.load(std::memory_order_acquire); 
+        for(; head != tail; head++){
+            pending.push_back(r->records[head & (LOG_RING_SIZE - 1)]); 
+        }
+        r->head.store(head, std::memory_order_release); 
+    }
+    std::stable_sort(pending.begin(), pending.end(), [](const LogRecord &x, const LogRecord &y){ return x.time < y.time; }); 
+
+    unsigned n = 0; 
+    std::string batch; 
+    for(; n < pending.size() && (all || pending[n].time < cutoff); n++){
+        if(mode == LOG_BINARY){
+            std::fwrite(&pending[n], sizeof(LogRecord), 1, out); 
+        }else{
+            batch += format(events, pending[n]); 
+            batch += '\n'; 
+        }
+    }
+    if(!batch.empty()){
+        std::fwrite(batch.data(), 1, batch.size(), out); 
+    }
+    if(n > 0){
+        std::fflush(out); 
+    }
+    pending.erase(pending.begin(), pending.begin() + n); 
+}
+
+/*Method write. Background thread that writes a batch each few milliseconds*/
+void Logger::write(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    while(!stopping){
+        cv_.wait_for(ul, std::chrono::milliseconds(LOG_FLUSH_MS), [this](){ return stopping; }); 
+        ul.unlock(); 
+        flush(false); 
+        ul.lock(); 
+    }
+}
+
+/*Method start. The lines of the level or lower are written with the mode, in binary mode to the file*/
+void Logger::start(int lvl, int m, std::string file){
+    level = lvl; 
+    mode  = m; 
+    if(mode == LOG_SYNC){
+        return; 
+    }
+    if(mode == LOG_BINARY){
+        out = std::fopen(file.c_str(), "wb"); 
+        if(out == nullptr){
+            std::cerr << "[LOGGER] ERROR. The log can't be written in " << file << std::endl; 
+            mode = LOG_ASYNC; 
+        }else{
+            int size = sizeof(LogRecord); 
+            std::fwrite(LOG_MAGIC, 1, std::strlen(LOG_MAGIC), out); 
+            std::fwrite(&size, sizeof(size), 1, out); 
+        }
+    }
+    if(mode == LOG_ASYNC){
+        std::cout.flush(); 
+        out = stdout; 
+    }
+    stopping = false; 
+    writer   = std::thread(&Logger::write, this); 
+}
+
+/*Method stop. It ends the writer after writing every record, the next lines are written to std::cout again*/
+void Logger::stop(){
+    if(!writer.joinable()){
+        return; 
+    }
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        stopping = true; 
+    }
+    cv_.notify_one(); 
+    writer.join(); 
+    flush(true); 
+    if(mode == LOG_BINARY){
+        std::fclose(out); 
+    }
+    out  = nullptr; 
+    mode = LOG_SYNC; 
+}
+
+/*Method getLevel*/
+int Logger::getLevel(){ return level; }
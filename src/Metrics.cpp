@@ -0,0 +1,227 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Metrics.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the counters, histograms and gauges of the system
+ * 
+ ******************************************************/
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <functional>
+#include <condition_variable>
+
+#include "../include/Metrics.h"
+
+/*Constructor of a shard*/
+Metrics::Shard::Shard(){
+    for(int i = 0; i < METRICS_MAX_COUNTERS; i++){
+        counters[i].store(0, std::memory_order_relaxed); 
+    }
+    for(int h = 0; h < METRICS_MAX_HISTOGRAMS; h++){
+        for(int b = 0; b < HISTOGRAM_BUCKETS; b++){
+            buckets[h][b].store(0, std::memory_order_relaxed); 
+        }
+        sums[h].store(0, std::memory_order_relaxed); 
+    }
+}
+
+/*Constructor*/
+Metrics::Metrics(): period_ms(0), stopping(false){}
+
+/*Destructor*/
+Metrics::~Metrics(){
+    stop(); 
+    for(unsigned i = 0; i < shards.size(); i++){
+        delete shards[i]; 
+    }
+}
+
+/*Method shard. Shard of the thread, it is created the first time the thread writes*/
+Metrics::Shard *Metrics::shard(){
+    Shard *local = locals.get(); 
+    if(local == nullptr){
+        local = new Shard; 
+        locals.set(local); 
+        std::lock_guard<std::mutex> lg(mutex_); 
+        shards.push_back(local); 
+    }
+    return local; 
+}
+
+/*Method addCounter. It returns the id of the counter*/
+int Metrics::addCounter(std::string name, std::string help){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    if(counters.size() >= METRICS_MAX_COUNTERS){
+        return -1; 
+    }
+    counters.push_back({name, help, nullptr}); 
+    return counters.size() - 1; 
+}
+
+/*Method addHistogram. It returns the id of the histogram*/
+int Metrics::addHistogram(std::string name, std::string help){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    if(histograms.size() >= METRICS_MAX_HISTOGRAMS){
+        return -1; 
+    }
+    histograms.push_back({name, help, nullptr}); 
+    return histograms.size() - 1; 
+}
+
+/*Method addGauge. The function gives the value when the snapshot is taken*/
+void Metrics::addGauge(std::string name, std::string help, std::function<long()> read){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    gauges.push_back({name, help, read}); 
+}
+
+/*Method increment. Only the thread of the shard writes it so it doesn't need an atomic add*/
+void Metrics::increment(int counter, long n){
+    if(counter < 0){
+        return; 
+    }
+    std::atomic<long> &c = shard()->counters[counter]; 
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); 
+}
+
+/*Method observe. The value goes to the bucket of its number of bits*/
+void Metrics::observe(int histogram, long value){
+    if(histogram < 0){
+        return; 
+    }
+    if(value < 0){
+        value = 0; 
+    }
+    int bucket = value == 0 ? 0 : 64 - __builtin_clzl(value); 
+    if(bucket >= HISTOGRAM_BUCKETS){
+        bucket = HISTOGRAM_BUCKETS - 1; 
+    }
+    Shard *s = shard(); 
+    std::atomic<long> &b   = s->buckets[histogram][bucket]; 
+    std::atomic<long> &sum = s->sums[histogram]; 
+    b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); 
+    sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); 
+}
+
+/*Method getCounter. Sum of every shard*/
+long Metrics::getCounter(int counter){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    long total = 0; 
+    for(unsigned i = 0; i < shards.size(); i++){
+        total += shards[i]->counters[counter].load(std::memory_order_relaxed); 
+    }
+    return total; 
+}
+
+/*Method getCount. Values observed in the histogram*/
+long Metrics::getCount(int histogram){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    long total = 0; 
+    for(unsigned i = 0; i < shards.size(); i++){
+        for(int b = 0; b < HISTOGRAM_BUCKETS; b++){
+            total += shards[i]->buckets[histogram][b].load(std::memory_order_relaxed); 
+        }
+    }
+    return total; 
+}
+
+/*Method getShards. Threads that have written a metric*/
+long Metrics::getShards(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return shards.size(); 
+}
+
+/*Method snapshot. It writes every metric in Prometheus text format*/
+void Metrics::snapshot(std::ostream &out){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    for(unsigned c = 0; c < counters.size(); c++){
+        long total = 0; 
+        for(unsigned i = 0; i < shards.size(); i++){
+            total += shards[i]->counters[c].load(std::memory_order_relaxed); 
+        }
+        out << "# HELP " << counters[c].name << " " << counters[c].help << "\n"; 
+        out << "# TYPE " << counters[c].name << " counter\n"; 
+        out << counters[c].name << " " << total << "\n"; 
+    }
+    for(unsigned g = 0; g < gauges.size(); g++){
+        out << "# HELP " << gauges[g].name << " " << gauges[g].help << "\n"; 
+        out << "# TYPE " << gauges[g].name << " gauge\n"; 
+        out << gauges[g].name << " " << gauges[g].read() << "\n"; 
+    }
+    for(unsigned h = 0; h < histograms.size(); h++){
+        long buckets[HISTOGRAM_BUCKETS] = {0}; 
+        long sum = 0; 
+        for(unsigned i = 0; i < shards.size(); i++){
+            for(int b = 0; b < HISTOGRAM_BUCKETS; b++){
+                buckets[b] += shards[i]->buckets[h][b].load(std::memory_order_relaxed); 
+            }
+            sum += shards[i]->sums[h].load(std::memory_order_relaxed); 
+        }
+        out << "# HELP " << histograms[h].name << " " << histograms[h].help << "\n"; 
+        out << "# TYPE " << histograms[h].name << " histogram\n"; 
+        long count = 0; 
+        for(int b = 0; b < HISTOGRAM_BUCKETS; b++){
+            count += buckets[b]; 
+            out << histograms[h].name << "_bucket{le=\"" << ((1L << b) - 1) << "\"} " << count << "\n"; 
+        }
+        out << histograms[h].name << "_bucket{le=\"+Inf\"} " << count << "\n"; 
+        out << histograms[h].name << "_sum " << sum << "\n"; 
+        out << histograms[h].name << "_count " << count << "\n"; 
+    }
+}
+
+/*Method writeFile. The snapshot is written in a temporary file and renamed so the readers never see it half written*/
+void Metrics::writeFile(){
+    std::string tmp = file + ".tmp"; 
+    {
+        std::ofstream out(tmp); 
+        if(!out){
+            return; 
+        }
+        snapshot(out); 
+    }
+    std::rename(tmp.c_str(), file.c_str()); 
+}
+
+/*Method write. Background thread that writes a snapshot each period*/
+void Metrics::write(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    bool last = false; 
+    while(!last){
+        cv_.wait_for(ul, std::chrono::milliseconds(period_ms), [this](){ return stopping; }); 
+        last = stopping; 
+        ul.unlock(); 
+        writeFile(); 
+        ul.lock(); 
+    }
+}
+
+/*Method start. It starts the thread that writes the snapshots in the file*/
+void Metrics::start(std::string f, long period){
+    file      = f; 
+    period_ms = period > 0 ? period : 1000; 
+    writer    = std::thread(&Metrics::write, this); 
+}
+
+/*Method stop. It ends the writer, the last snapshot is written*/
+void Metrics::stop(){
+    if(!writer.joinable()){
+        return; 
+    }
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        stopping = true; 
+    }
+    cv_.notify_one(); 
+    writer.join(); 
+}
@@ -0,0 +1,224 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    PaymentGateway.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the asynchronous payment gateway
+ * 
+ ******************************************************/
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+#include "../include/PaymentGateway.h"
+
+/*Constructor. It starts the dispatcher and the completer*/
+PaymentGateway::PaymentGateway(int w, long l, int d, double f, int r, long s, VirtualClock *c, unsigned long seed): window(w > 0 ? w : 1), latency_us(l), distribution(d), failure_rate(f), 
+                                                                rng(std::random_device()()), rng_failures(rng()), clock(c), pending({r, 1}, s, c), permits(w > 0 ? w : 1), 
+                                                                stopping(false), num_approved(0), num_rejected(0), num_in_flight(0), max_in_flight(0){
+    if(seed != 0){ /*the same seed gives the same latencies and failures*/
+        std::seed_seq latencies{seed, 1UL}; 
+        std::seed_seq failures{seed, 2UL}; 
+        rng.seed(latencies); 
+        rng_failures.seed(failures); 
+    }
+    if(clock != nullptr){
+        clock->enter(); /*the dispatcher takes part in the simulation*/
+    }
+    dispatcher = std::thread(&PaymentGateway::dispatch, this); 
+    completer  = std::thread(&PaymentGateway::complete, this); 
+}
+
+/*Destructor*/
+PaymentGateway::~PaymentGateway(){ stop(); }
+
+/*Method sampleLatency. Latency of the next authorization following the distribution*/
+long PaymentGateway::sampleLatency(){
+    if(latency_us <= 0){
+        return 0; 
+    }
+    switch(distribution){
+        case LATENCY_UNIFORM:
+            return std::uniform_int_distribution<long>(0, 2 * latency_us)(rng); 
+        case LATENCY_EXPONENTIAL:
+            return static_cast<long>(std::exponential_distribution<double>(1.0 / latency_us)(rng)); 
+        default:
+            return latency_us; 
+    }
+}
+
+/*Method paymentClass. Class of the scheduler of each type of payment*/
+int PaymentGateway::paymentClass(int type){
+    return (type >= 1 && type <= PAYMENT_CLASSES) ? type - 1 : PAYMENT_CLASSES - 1; 
+}
+
+/*Method dispatch. It sends each request to the processor when there is a free place in the window*/
+void PaymentGateway::dispatch(){
+    while(true){
+        Authorization *auth = nullptr; 
+        if(clock != nullptr){
+            clock->waitFor(&permits, [this](){ return permits.try_wait(); }); 
+            clock->waitFor(&pending, [this, &auth](){ return pending.try_pop(auth) || pending.isClosed(); }); 
+            if(auth == nullptr){
+                break; 
+            }
+        }else{
+            permits.wait(); 
+            if(!pending.pop(auth)){
+                break; 
+            }
+        }
+        long latency = sampleLatency(); 
+        {
+            std::lock_guard<std::mutex> lg(mutex_); 
+            num_in_flight++; 
+            if(num_in_flight > max_in_flight){
+                max_in_flight = num_in_flight; 
+            }
+            if(clock == nullptr){
+                auth->deadline = SteadyClock::now() + std::chrono::microseconds(latency); 
+                in_flight.push(auth); 
+            }
+        }
+        if(clock != nullptr){
+            clock->schedule(latency, [this, auth](){ answer(auth, decide()); }); 
+        }else{
+            cv_.notify_one(); 
+        }
+    }
+    if(clock != nullptr){
+        clock->leave(); 
+    }
+}
+
+/*Method decide. Result of the processor, it counts the payments approved and rejected*/
+bool PaymentGateway::decide(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    bool approved = std::uniform_real_distribution<double>(0.0, 1.0)(rng_failures) >= failure_rate; 
+    if(approved){
+        num_approved++; 
+    }else{
+        num_rejected++; 
+    }
+    num_in_flight--; 
+    return approved; 
+}
+
+/*Method answer. It gives back the place of the window and the result to the requester*/
+void PaymentGateway::answer(Authorization *auth, bool approved){
+    permits.signal(); 
+    if(clock != nullptr){
+        clock->notify(&permits); 
+    }
+    auth->mrp->attended = true; 
+    auth->on_done(approved); 
+    authorizations.destroy(auth); 
+}
+
+/*Method complete. It answers the authorizations in order of deadline*/
+void PaymentGateway::complete(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+
+    while(true){
+        if(in_flight.empty()){
+            if(stopping){
+                break; 
+            }
+            cv_.wait(ul); 
+            continue; 
+        }
+        SteadyClock::time_point deadline = in_flight.top()->deadline; 
+        if(SteadyClock::now() < deadline){
+            cv_.wait_until(ul, deadline); 
+            continue; 
+        }
+        Authorization *auth = in_flight.top(); 
+        in_flight.pop(); 
+        ul.unlock(); 
+
+        answer(auth, decide()); 
+
+        ul.lock(); 
+    }
+}
+
+/*Method authorize. The callback receives the result of the payment in the thread of the gateway*/
+void PaymentGateway::authorize(MsgRequestPayment *mrp, Callback on_done){
+    Authorization *auth = authorizations.create(); 
+    auth->mrp           = mrp; 
+    auth->on_done       = std::move(on_done); 
+    pending.push(paymentClass(mrp->type), auth); 
+    if(clock != nullptr){
+        clock->notify(&pending); 
+    }
+}
+
+/*Method authorize. The future receives the result of the payment*/
+std::future<bool> PaymentGateway::authorize(MsgRequestPayment *mrp){
+    std::shared_ptr<std::promise<bool>> result = std::make_shared<std::promise<bool>>(); 
+    authorize(mrp, [result](bool approved){ result->set_value(approved); }); 
+    return result->get_future(); 
+}
+
+/*Method stop. It answers the authorizations already sent and ends the threads*/
+void PaymentGateway::stop(){
+    if(!dispatcher.joinable()){
+        return; 
+    }
+    pending.close(); 
+    if(clock != nullptr){
+        clock->notify(&pending); 
+    }
+    dispatcher.join(); 
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        stopping = true; 
+    }
+    cv_.notify_one(); 
+    completer.join(); 
+}
+
+/*Method setPooled. Before the first payment, false allocates each authorization with new*/
+void PaymentGateway::setPooled(bool pooled){ authorizations.setPooled(pooled); }
+
+/*Method getWindow*/
+int PaymentGateway::getWindow(){ return window; }
+
+/*Method getApproved*/
+long PaymentGateway::getApproved(){ 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return num_approved; 
+}
+
+/*Method getRejected*/
+long PaymentGateway::getRejected(){ 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return num_rejected; 
+}
+
+/*Method getMaxInFlight*/
+int PaymentGateway::getMaxInFlight(){ 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return max_in_flight; 
+}
+
+/*Method getInFlight. Payments sent to the processor without answer*/
+int PaymentGateway::getInFlight(){ 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return num_in_flight; 
+}
+
+/*Method getWaitPercentile. Wait in microseconds before being sent of the payments of the type*/
+long PaymentGateway::getWaitPercentile(int type, double p){ return pending.getWaitPercentile(paymentClass(type), p); }
+
+/*Method getStarved*/
+long PaymentGateway::getStarved(){ return pending.getStarved(); }
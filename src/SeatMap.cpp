@@ -0,0 +1,240 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    SeatMap.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the map of seats of a hall
+ * 
+ ******************************************************/
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <cstdlib>
+
+#include "../include/SeatMap.h"
+
+/*Constructor. Every seat starts free, the bits after the last column stay at 0*/
+SeatMap::SeatMap(int r, int c): rows(r), cols(c), words_per_row((c + 63) / 64), num_free(r * c){
+    free_bits.assign(rows * words_per_row, 0); 
+    free_per_row.assign(rows, cols); 
+    run_per_row.assign(rows, cols); 
+    run_exact.assign(rows, 1); 
+    for(int row = 0; row < rows; row++){
+        for(int col = 0; col < cols; col++){
+            free_bits[row * words_per_row + col / 64] |= 1ULL << (col % 64); 
+        }
+    }
+}
+
+/*Method findBlock. First column of N adjacent free seats in the row or -1.
+  Inside a word the block is found with log2(N) shifts and ands, and carry 
+  keeps the free seats at the end of the previous words for the blocks that cross them*/
+int SeatMap::findBlock(int row, int n){
+    const uint64_t *words = &free_bits[row * words_per_row]; 
+    int carry = 0; 
+
+    for(int w = 0; w < words_per_row; w++){
+        uint64_t x      = words[w]; 
+        int      prefix = (x == ~0ULL) ? 64 : __builtin_ctzll(~x); 
+        if(carry > 0 && carry + prefix >= n){
+            return w * 64 - carry; 
+        }
+        if(n <= 64){
+            uint64_t y = x; 
+            for(int k = 1; k < n && y != 0; ){
+                int s  = (k < n - k) ? k : n - k; 
+                y     &= y >> s; 
+                k     += s; 
+            }
+            if(y != 0){
+                return w * 64 + __builtin_ctzll(y); 
+            }
+        }
+        carry = (x == ~0ULL) ? carry + 64 : __builtin_clzll(~x); 
+    }
+    return -1; 
+}
+
+/*Method longestRun. Size of the largest block of free seats in the row. The blocks inside a word are jumped 
+  with ctz, carry keeps the free seats at the end of the previous words*/
+int SeatMap::longestRun(int row){
+    const uint64_t *words = &free_bits[row * words_per_row]; 
+    int best  = 0; 
+    int carry = 0; 
+
+    for(int w = 0; w < words_per_row; w++){
+        uint64_t x = words[w]; 
+        if(x == ~0ULL){
+            carry += 64; 
+            continue; 
+        }
+        int prefix = __builtin_ctzll(~x); 
+        best       = (carry + prefix > best) ? carry + prefix : best; 
+        for(uint64_t y = x >> prefix; y != 0; ){
+            y     >>= __builtin_ctzll(y); 
+            int len = __builtin_ctzll(~y); 
+            best    = (len > best) ? len : best; 
+            y     >>= len; 
+        }
+        carry = __builtin_clzll(~x); 
+    }
+    return (carry > best) ? carry : best; 
+}
+
+/*Method runAt. Size of the block of free seats that has the free seat of the column*/
+int SeatMap::runAt(int row, int col){
+    const uint64_t *words = &free_bits[row * words_per_row]; 
+    int w   = col / 64; 
+    int bit = col % 64; 
+
+    /*To the right, from the seat*/
+    uint64_t taken = ~(words[w] >> bit); 
+    int right = (taken == 0) ? 64 : __builtin_ctzll(taken); 
+    for(int k = w + 1; right == 64 * (k - w) - bit && k < words_per_row; k++){
+        right += (words[k] == ~0ULL) ? 64 : __builtin_ctzll(~words[k]); 
+    }
+    /*To the left, before the seat*/
+    int left = (bit == 0) ? 0 : __builtin_clzll(~(words[w] << (64 - bit))); 
+    for(int k = w - 1; left == bit + 64 * (w - 1 - k) && k >= 0; k--){
+        left += (words[k] == ~0ULL) ? 64 : __builtin_clzll(~words[k]); 
+    }
+    return left + right; 
+}
+
+/*Method largestRun. Largest block of free seats of the row, it is counted again only if a sale has changed it*/
+int SeatMap::largestRun(int row){
+    if(!run_exact[row]){
+        run_per_row[row] = longestRun(row); 
+        run_exact[row]   = 1; 
+    }
+    return run_per_row[row]; 
+}
+
+/*Method take. It marks as sold N seats from the column*/
+void SeatMap::take(int row, int col, int n, std::vector<int> &seats){
+    for(int c = col; c < col + n; c++){
+        seats.push_back(row * cols + c); 
+    }
+    for(int c = col; c < col + n; ){
+        int      bit  = c % 64; 
+        int      len  = (64 - bit < col + n - c) ? 64 - bit : col + n - c; 
+        uint64_t mask = (len == 64) ? ~0ULL : ((1ULL << len) - 1) << bit; 
+        free_bits[row * words_per_row + c / 64] &= ~mask; 
+        c += len; 
+    }
+    free_per_row[row]  -= n; 
+    num_free           -= n; 
+    run_exact[row]      = 0; 
+}
+
+/*Method allocate. It gives N adjacent seats in the same row. If no row has them, 
+  it takes the largest block and fills the rest from the nearest rows*/
+bool SeatMap::allocate(int n, std::vector<int> &seats){
+    if(n <= 0 || n > num_free){
+        return false; 
+    }
+
+    /*A row whose bound is too small is skipped, if the bound was too large it is counted again*/
+    for(int row = 0; row < rows; row++){
+        if(run_per_row[row] < n){
+            continue; 
+        }
+        int col = findBlock(row, n); 
+        if(col >= 0){
+            take(row, col, n, seats); 
+            return true; 
+        }
+        largestRun(row); 
+    }
+
+    /*Closest split: start in the row with the largest block*/
+    int anchor = 0, best = 0; 
+    for(int row = 0; row < rows; row++){
+        if(run_per_row[row] > best && largestRun(row) > best){
+            best   = run_per_row[row]; 
+            anchor = row; 
+        }
+    }
+
+    int left = n; 
+    while(left > 0){
+        /*Nearest row to the anchor that still has free seats*/
+        int row = -1; 
+        for(int d = 0; row < 0; d++){
+            if(anchor - d >= 0 && free_per_row[anchor - d] > 0){
+                row = anchor - d; 
+            }else if(anchor + d < rows && free_per_row[anchor + d] > 0){
+                row = anchor + d; 
+            }
+        }
+        int used = (largestRun(row) < left) ? run_per_row[row] : left; 
+        take(row, findBlock(row, used), used, seats); 
+        left -= used; 
+    }
+    return true; 
+}
+
+/*Method allocateSeat. It sells one given seat if it is free*/
+bool SeatMap::allocateSeat(int seat){
+    if(!isFree(seat)){
+        return false; 
+    }
+    std::vector<int> seats; 
+    take(seat / cols, seat % cols, 1, seats); 
+    return true; 
+}
+
+/*Method release. The seats are free again. A block that grows has one of them, so the bound of the row 
+  only has to take the block of the last seat of each group of adjacent ones*/
+void SeatMap::release(const std::vector<int> &seats){
+    for(unsigned i = 0; i < seats.size(); i++){
+        int row = seats[i] / cols; 
+        int col = seats[i] % cols; 
+        if(!isFree(seats[i])){
+            free_bits[row * words_per_row + col / 64] |= 1ULL << (col % 64); 
+            free_per_row[row]++; 
+            num_free++; 
+        }
+        if(i + 1 < seats.size() && seats[i + 1] == seats[i] + 1 && col + 1 < cols){
+            continue;   /*the next seat is in the same block*/
+        }
+        int run = runAt(row, col); 
+        if(run > run_per_row[row]){
+            run_per_row[row] = run; 
+        }
+    }
+}
+
+/*Method isFree*/
+bool SeatMap::isFree(int seat){
+    int row = seat / cols; 
+    int col = seat % cols; 
+    return (free_bits[row * words_per_row + col / 64] >> (col % 64)) & 1ULL; 
+}
+
+/*Method getFree*/
+int SeatMap::getFree(){ return num_free; }
+
+/*Method getRows*/
+int SeatMap::getRows(){ return rows; }
+
+/*Method getCols*/
+int SeatMap::getCols(){ return cols; }
+
+/*Method getCapacity*/
+int SeatMap::getCapacity(){ return rows * cols; }
+
+/*Method seatName. Row as a letter and column from 1, for example C7*/
+std::string SeatMap::seatName(int seat){
+    int  row = seat / cols; 
+    std::string name; 
+    do{
+        name.insert(name.begin(), static_cast<char>('A' + row % 26)); 
+        row = row / 26 - 1; 
+    }while(row >= 0); 
+    return name + std::to_string(seat % cols + 1); 
+}
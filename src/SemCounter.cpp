@@ -1,7 +1,7 @@
 /******************************************************
  * Project:         Práctica 3 de Sistemas Operativos II
  * 
- * Program name:    msgRequest.cpp
+ * Program name:    SemCounter.cpp
  
  * Author:          María Espinosa Astilleros
  * 
@@ -14,38 +14,67 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <condition_variable>
 
 #include "../include/SemCounter.h"
 
 /*Constructor*/
 SemCounter::SemCounter(int v): value(v){}; 
 
-/*Method block*/
-void SemCounter::block(){ mutex_block.lock(); }
+/*Method wait. It blocks until there is a permit and takes it*/
+void SemCounter::wait(){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    cv_.wait(ul, [this]{return value > 0;}); 
+    --value; 
+}
 
-/*Method unblock*/
-void SemCounter::unblock(){ mutex_block.unlock(); }
+/*Method try_wait. It takes a permit only if there is one available*/
+bool SemCounter::try_wait(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    if(value <= 0){
+        return false; 
+    }
+    --value; 
+    return true; 
+}
 
-/*Method wait*/
-void SemCounter::wait(){
-    mutex_.lock(); 
-    if(--value <=0){
-        mutex_.unlock(); 
-        block(); 
-        mutex_.lock();
+/*Method wait_for. Same as wait but it gives up when the timeout expires*/
+bool SemCounter::wait_for(std::chrono::nanoseconds timeout){
+    std::unique_lock<std::mutex> ul(mutex_); 
+    if(!cv_.wait_for(ul, timeout, [this]{return value > 0;})){
+        return false; 
     }
-    mutex_.unlock(); 
+    --value; 
+    return true; 
 }
 
 /*Method signal*/
 void SemCounter::signal(){
-    mutex_.lock(); 
-    if(++value <= 0){
-        unblock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(200)); 
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        ++value; 
+    }
+    cv_.notify_one(); 
+}
+
+/*Method signal. It releases n permits at once*/
+void SemCounter::signal(int n){
+    if(n <= 0){
+        return; 
+    }
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        value += n; 
+    }
+    if(n == 1){
+        cv_.notify_one(); 
+    }else{
+        cv_.notify_all(); 
     }
-    mutex_.unlock(); 
 }
 
 /*Method getValue*/
-int SemCounter::getValue(){ return value; }
\ No newline at end of file
+int SemCounter::getValue(){ 
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return value; 
+}
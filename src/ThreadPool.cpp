@@ -0,0 +1,80 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    ThreadPool.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the fixed pool of workers
+ * 
+ ******************************************************/
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "../include/ThreadPool.h"
+
+/*Constructor. It starts the workers*/
+ThreadPool::ThreadPool(int num_workers): stop(false){
+    if(num_workers <= 0){
+        num_workers = std::thread::hardware_concurrency(); 
+    }
+    if(num_workers <= 0){
+        num_workers = 1; 
+    }
+    for(int i = 0; i < num_workers; i++){
+        workers.push_back(std::thread(&ThreadPool::work, this)); 
+    }
+}
+
+/*Destructor*/
+ThreadPool::~ThreadPool(){ shutdown(); }
+
+/*Method work. Loop of each worker, it ends when the pool stops and there are no tasks left*/
+void ThreadPool::work(){
+    while(true){
+        std::function<void()> task; 
+        {
+            std::unique_lock<std::mutex> ul(mutex_); 
+            cv_.wait(ul, [this]{return stop || !tasks.empty();}); 
+            if(tasks.empty()){
+                return; 
+            }
+            task = std::move(tasks.front()); 
+            tasks.pop(); 
+        }
+        task(); 
+    }
+}
+
+/*Method submit*/
+void ThreadPool::submit(std::function<void()> task){
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        tasks.push(std::move(task)); 
+    }
+    cv_.notify_one(); 
+}
+
+/*Method shutdown. It runs the pending tasks and joins the workers*/
+void ThreadPool::shutdown(){
+    {
+        std::lock_guard<std::mutex> lg(mutex_); 
+        if(stop){
+            return; 
+        }
+        stop = true; 
+    }
+    cv_.notify_all(); 
+    for(unsigned i = 0; i < workers.size(); i++){
+        workers[i].join(); 
+    }
+}
+
+/*Method size*/
+int ThreadPool::size(){ return workers.size(); }
@@ -0,0 +1,180 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    TimingWheel.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the hierarchical timing wheel of the holds
+ * 
+ ******************************************************/
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+#include "../include/TimingWheel.h"
+
+/*Constructor*/
+TimingWheel::TimingWheel(long t): tick_us(t > 0 ? t : 1), current(0), armed(0), fired(0), free_list(-1), firing(false){
+    for(int i = 0; i < WHEEL_LEVELS * WHEEL_SLOTS; i++){
+        heads[i] = -1; 
+    }
+}
+
+/*Method link. The node goes to the front of the list of the slot*/
+void TimingWheel::link(int index, int slot){
+    Node &n  = nodes[index]; 
+    n.slot   = slot; 
+    n.prev   = -1; 
+    n.next   = heads[slot]; 
+    if(n.next >= 0){
+        nodes[n.next].prev = index; 
+    }
+    heads[slot] = index; 
+}
+
+/*Method unlink. The node leaves the list of its slot*/
+void TimingWheel::unlink(int index){
+    Node &n = nodes[index]; 
+    if(n.prev >= 0){
+        nodes[n.prev].next = n.next; 
+    }else{
+        heads[n.slot] = n.next; 
+    }
+    if(n.next >= 0){
+        nodes[n.next].prev = n.prev; 
+    }
+    n.slot = -1; 
+}
+
+/*Method place. The level is the first one whose slots reach the tick, a tick already passed expires in the next one*/
+void TimingWheel::place(int index){
+    long expires = nodes[index].expires; 
+    long delta   = expires - current; 
+    if(delta < 0){
+        expires = current; 
+        delta   = 0; 
+    }else if(delta >= WHEEL_RANGE){
+        expires = current + WHEEL_RANGE - 1; /*it is placed again when the last level goes round*/
+        delta   = WHEEL_RANGE - 1; 
+    }
+    int level = 0; 
+    while(delta >= (1L << ((level + 1) * WHEEL_BITS))){
+        level++; 
+    }
+    link(index, level * WHEEL_SLOTS + ((expires >> (level * WHEEL_BITS)) & WHEEL_MASK)); 
+}
+
+/*Method cascade. The slot of the level that the current tick enters is spread over the levels below*/
+void TimingWheel::cascade(int level){
+    int slot  = level * WHEEL_SLOTS + ((current >> (level * WHEEL_BITS)) & WHEEL_MASK); 
+    int index = heads[slot]; 
+    heads[slot] = -1; 
+    while(index >= 0){
+        int next = nodes[index].next; 
+        place(index); 
+        index = next; 
+    }
+}
+
+/*Method release. The node goes back to the pool*/
+void TimingWheel::release(int index){
+    nodes[index].generation++; 
+    nodes[index].slot = -1; 
+    nodes[index].next = free_list; 
+    free_list = index; 
+    armed--; 
+}
+
+/*Method arm. It returns the handle to cancel the timer, first is true if the wheel was empty*/
+unsigned long TimingWheel::arm(long deadline_us, void *data, bool *first){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    int index; 
+    if(free_list >= 0){
+        index     = free_list; 
+        free_list = nodes[index].next; 
+    }else{
+        index = nodes.size(); 
+        nodes.push_back({0, nullptr, 0, -1, -1, -1}); 
+    }
+    nodes[index].expires = (deadline_us + tick_us - 1) / tick_us; 
+    nodes[index].data    = data; 
+    place(index); 
+    if(first != nullptr){
+        *first = armed == 0; 
+    }
+    armed++; 
+    return (static_cast<unsigned long>(nodes[index].generation) << 32) | static_cast<unsigned long>(index + 1); 
+}
+
+/*Method cancel. True if the timer won't fire. If it has fired it waits until its callback has ended*/
+bool TimingWheel::cancel(unsigned long handle){
+    int index           = static_cast<int>(handle & 0xffffffffUL) - 1; 
+    unsigned generation = static_cast<unsigned>(handle >> 32); 
+    std::unique_lock<std::mutex> ul(mutex_); 
+    if(index < 0 || index >= static_cast<int>(nodes.size()) || nodes[index].generation != generation || nodes[index].slot < 0){
+        fired_.wait(ul, [this](){ return !firing; }); 
+        return false; 
+    }
+    unlink(index); 
+    release(index); 
+    return true; 
+}
+
+/*Method expire. It runs the callback of every timer until now and returns how many have fired*/
+long TimingWheel::expire(long now_us, const std::function<void(void*)> &callback){
+    long last  = now_us / tick_us; 
+    long count = 0; 
+    std::vector<void*> due; 
+    std::unique_lock<std::mutex> ul(mutex_); 
+    while(current <= last){
+        if(armed == 0){
+            current = last + 1; /*an empty wheel jumps to now*/
+            break; 
+        }
+        for(int level = 1; level < WHEEL_LEVELS && ((current >> ((level - 1) * WHEEL_BITS)) & WHEEL_MASK) == 0; level++){
+            cascade(level); 
+        }
+        int slot  = current & WHEEL_MASK; 
+        int index = heads[slot]; 
+        heads[slot] = -1; 
+        current++; 
+        if(index < 0){
+            continue; 
+        }
+        due.clear(); 
+        while(index >= 0){
+            int next = nodes[index].next; 
+            due.push_back(nodes[index].data); 
+            release(index); 
+            index = next; 
+        }
+        firing = true; 
+        fired += due.size(); 
+        ul.unlock(); 
+        for(unsigned i = 0; i < due.size(); i++){
+            callback(due[i]); 
+        }
+        count += due.size(); 
+        ul.lock(); 
+        firing = false; 
+        fired_.notify_all(); 
+    }
+    return count; 
+}
+
+/*Method getArmed. Timers waiting*/
+long TimingWheel::getArmed(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return armed; 
+}
+
+/*Method getFired. Timers that have expired*/
+long TimingWheel::getFired(){
+    std::lock_guard<std::mutex> lg(mutex_); 
+    return fired; 
+}
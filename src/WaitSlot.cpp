@@ -0,0 +1,59 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    WaitSlot.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the slot where a thread waits to be handed the turn
+ * 
+ ******************************************************/
+#include <atomic>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "../include/WaitSlot.h"
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "the futex word is the atomic itself"); 
+
+/*Constructor*/
+WaitSlot::WaitSlot(int value): permits(value), sleepers(0){}
+
+/*Method wait. It sleeps in the futex while there are no permits. It doesn't spin, the turns it waits for 
+  take a service time and spinning with yield costs a context switch each time*/
+void WaitSlot::wait(){
+    if(try_wait()){
+        return; 
+    }
+    sleepers.fetch_add(1, std::memory_order_seq_cst); 
+    while(!try_wait()){
+        /*The kernel checks that permits is still 0 before sleeping, a signal meanwhile makes it return at once*/
+        syscall(SYS_futex, reinterpret_cast<int*>(&permits), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0); 
+    }
+    sleepers.fetch_sub(1, std::memory_order_relaxed); 
+}
+
+/*Method try_wait. It takes a permit only if there is one*/
+bool WaitSlot::try_wait(){
+    int value = permits.load(std::memory_order_relaxed); 
+    while(value > 0){
+        if(permits.compare_exchange_weak(value, value - 1, std::memory_order_acquire, std::memory_order_relaxed)){
+            return true; 
+        }
+    }
+    return false; 
+}
+
+/*Method signal. A sleeper that registered before the permit was added is always seen here*/
+void WaitSlot::signal(){
+    permits.fetch_add(1, std::memory_order_seq_cst); 
+    if(sleepers.load(std::memory_order_seq_cst) > 0){
+        syscall(SYS_futex, reinterpret_cast<int*>(&permits), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0); 
+    }
+}
+
+/*Method getValue*/
+int WaitSlot::getValue(){ return permits.load(std::memory_order_relaxed); }
@@ -0,0 +1,221 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    Workload.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Contain the implementation of the generator of the arrivals of the clients
+ * 
+ ******************************************************/
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+#include "../include/Workload.h"
+
+/*Constructor. By default a client each second, setDistributions gives the quantities*/
+Workload::Workload(unsigned long s): arrivals(ARRIVAL_FIXED), rate(1), burst_factor(1), burst_on_s(0), burst_off_s(0), group_share(0),
+                                     group_showings(1), spec("fixed"), seed(s), rng(stream(s, 0)), now_us(0), in_burst(false), state_end_us(0), next_trace(0){
+    seats   = {DIST_UNIFORM, 1, 1, 1, 1}; 
+    drinks  = {DIST_UNIFORM, 1, 1, 1, 1}; 
+    popcorn = {DIST_UNIFORM, 1, 1, 1, 1}; 
+}
+
+/*Method stream. Generator of the stream id of the seed, each thread that needs random numbers takes its own*/
+std::mt19937_64 Workload::stream(unsigned long seed, unsigned long id){
+    std::seed_seq sequence{seed, id}; 
+    return std::mt19937_64(sequence); 
+}
+
+/*Method parseDistribution. uniform:min:max, fixed:n, poisson:mean or geometric:p*/
+bool Workload::parseDistribution(std::string text, int min, int max, Distribution &d){
+    std::vector<std::string> fields; 
+    std::stringstream ss(text); 
+    std::string field; 
+    while(std::getline(ss, field, ':')){
+        fields.push_back(field); 
+    }
+    if(fields.empty()){
+        return false; 
+    }
+    try{
+        if(fields[0] == "uniform" && fields.size() == 3){
+            d = {DIST_UNIFORM, std::stod(fields[1]), std::stod(fields[2]), min, max}; 
+        }else if(fields[0] == "fixed" && fields.size() == 2){
+            d = {DIST_FIXED, std::stod(fields[1]), 0, min, max}; 
+        }else if(fields[0] == "poisson" && fields.size() == 2){
+            d = {DIST_POISSON, std::stod(fields[1]), 0, min, max}; 
+        }else if(fields[0] == "geometric" && fields.size() == 2 && std::stod(fields[1]) > 0 && std::stod(fields[1]) <= 1){
+            d = {DIST_GEOMETRIC, std::stod(fields[1]), 0, min, max}; 
+        }else{
+            return false; 
+        }
+    }catch(std::exception &e){
+        return false; 
+    }
+    return true; 
+}
+
+/*Method setArrivals. fixed, poisson, bursty:factor:on_s:off_s or trace:file.csv*/
+bool Workload::setArrivals(std::string text, double r){
+    rate = r; 
+    spec = text; 
+    if(text == "fixed"){
+        arrivals = ARRIVAL_FIXED; 
+        return true; 
+    }
+    if(text == "poisson"){
+        arrivals = ARRIVAL_POISSON; 
+        return true; 
+    }
+    if(text.compare(0, 6, "trace:") == 0){
+        arrivals = ARRIVAL_TRACE; 
+        return loadTrace(text.substr(6)); 
+    }
+    if(text.compare(0, 7, "bursty:") == 0){
+        std::stringstream ss(text.substr(7)); 
+        char colon1 = 0, colon2 = 0; 
+        ss >> burst_factor >> colon1 >> burst_on_s >> colon2 >> burst_off_s; 
+        if(!ss || colon1 != ':' || colon2 != ':' || burst_factor <= 0 || burst_on_s <= 0 || burst_off_s <= 0){
+            return false; 
+        }
+        arrivals     = ARRIVAL_BURSTY; 
+        in_burst     = false; 
+        state_end_us = static_cast<long>(std::exponential_distribution<double>(1.0 / burst_off_s)(rng) * 1e6); 
+        return true; 
+    }
+    return false; 
+}
+
+/*Method setDistributions. Distributions of seats, drinks and popcorn separated by /*/
+bool Workload::setDistributions(std::string text, int max_seats, int max_food){
+    std::vector<std::string> parts; 
+    std::stringstream ss(text); 
+    std::string part; 
+    while(std::getline(ss, part, '/')){
+        parts.push_back(part); 
+    }
+    return parts.size() == 3 && parseDistribution(parts[0], 1, max_seats, seats)
+        && parseDistribution(parts[1], 1, max_food, drinks) && parseDistribution(parts[2], 1, max_food, popcorn); 
+}
+
+/*Method setGroups. A share of the clients book the same seats in several consecutive showings*/
+void Workload::setGroups(double share, int showings){
+    group_share    = share; 
+    group_showings = showings; 
+}
+
+/*Method loadTrace. Lines time_ms,showing,seats,drinks,popcorn. The columns after the time can be missing or 0
+  and then they are generated, larger than the maximum of their distribution they are cut to it in next. 
+  The lines that don't start with a number are skipped*/
+bool Workload::loadTrace(std::string file){
+    std::ifstream in(file); 
+    if(!in){
+        return false; 
+    }
+    trace.clear(); 
+    std::string line; 
+    while(std::getline(in, line)){
+        if(line.empty() || !(std::isdigit(static_cast<unsigned char>(line[0])) || line[0] == '.')){
+            continue; 
+        }
+        std::vector<double> values; 
+        std::stringstream ss(line); 
+        std::string field; 
+        while(std::getline(ss, field, ',')){
+            try{
+                values.push_back(field.empty() ? 0 : std::stod(field)); 
+            }catch(std::exception &e){
+                values.push_back(0); 
+            }
+        }
+        values.resize(5, 0); 
+        trace.push_back({static_cast<long>(values[0] * 1000), static_cast<int>(values[1]), static_cast<int>(values[2]),
+                         static_cast<int>(values[3]), static_cast<int>(values[4]), 0}); 
+    }
+    std::stable_sort(trace.begin(), trace.end(), [](const Arrival &x, const Arrival &y){ return x.at_us < y.at_us; }); 
+    return !trace.empty(); 
+}
+
+/*Method sample. Value of the distribution between its minimum and maximum*/
+int Workload::sample(const Distribution &d){
+    long value; 
+    switch(d.kind){
+        case DIST_FIXED:
+            value = static_cast<long>(d.a); 
+            break; 
+        case DIST_POISSON:
+            value = std::poisson_distribution<long>(d.a)(rng); 
+            break; 
+        case DIST_GEOMETRIC:
+            value = 1 + std::geometric_distribution<long>(d.a)(rng); 
+            break; 
+        default:
+            value = std::uniform_int_distribution<long>(static_cast<long>(d.a), std::max(static_cast<long>(d.a), static_cast<long>(d.b)))(rng); 
+    }
+    return static_cast<int>(std::min(std::max(value, static_cast<long>(d.min)), static_cast<long>(d.max))); 
+}
+
+/*Method interarrival. Microseconds until the next client with rate r*/
+long Workload::interarrival(double r){
+    if(arrivals == ARRIVAL_FIXED){
+        return static_cast<long>(1e6 / r); 
+    }
+    return static_cast<long>(std::exponential_distribution<double>(r)(rng) * 1e6); 
+}
+
+/*Method next. Next client, with the microseconds since the start of the generator when it arrives. 
+  The first one arrives at the start*/
+Arrival Workload::next(int showings){
+    Arrival a = {now_us, 0, 0, 0, 0, 0}; 
+    if(arrivals == ARRIVAL_TRACE){
+        if(next_trace < trace.size()){
+            a = trace[next_trace++]; 
+        }
+        now_us = a.at_us; 
+    }else if(rate > 0){
+        /*Time of the client after this one*/
+        if(arrivals == ARRIVAL_BURSTY){
+            /*The rate changes at the end of each state, the exponential doesn't remember so it is sampled again*/
+            long at = now_us + interarrival(in_burst ? rate * burst_factor : rate); 
+            while(at > state_end_us){
+                now_us       = state_end_us; 
+                in_burst     = !in_burst; 
+                state_end_us = now_us + static_cast<long>(std::exponential_distribution<double>(1.0 / (in_burst ? burst_on_s : burst_off_s))(rng) * 1e6); 
+                at           = now_us + interarrival(in_burst ? rate * burst_factor : rate); 
+            }
+            now_us = at; 
+        }else{
+            now_us += interarrival(rate); 
+        }
+    }
+    if(a.showing < 1 || a.showing > showings){
+        a.showing = std::uniform_int_distribution<int>(1, showings)(rng); 
+    }
+    a.seats   = a.seats   > 0 ? std::min(a.seats, seats.max)     : sample(seats); 
+    a.drinks  = a.drinks  > 0 ? std::min(a.drinks, drinks.max)   : sample(drinks); 
+    a.popcorn = a.popcorn > 0 ? std::min(a.popcorn, popcorn.max) : sample(popcorn); 
+    a.showings = 1; 
+    if(group_share > 0 && std::uniform_real_distribution<double>(0, 1)(rng) < group_share){ /*without groups the stream is the same*/
+        a.showings = group_showings; 
+    }
+    return a; 
+}
+
+/*Method getNumClients. The clients of the trace or the requested ones*/
+int Workload::getNumClients(int requested){
+    return arrivals == ARRIVAL_TRACE ? static_cast<int>(trace.size()) : requested; 
+}
+
+/*Method getSeed*/
+unsigned long Workload::getSeed(){ return seed; }
+
+/*Method getArrivals. Description of the arrival process*/
+std::string Workload::getArrivals(){ return spec; }
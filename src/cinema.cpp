@@ -20,106 +20,809 @@
 #include <chrono> 
 #include <csignal>
 #include <string> 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdlib>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/resource.h>
+#include <fstream>
+#include <algorithm>
 
 #include "../include/color.h"
 #include "../include/msgRequest.h"
-#include "../include/SemCounter.h"
+#include "../include/WaitSlot.h"
+#include "../include/ThreadPool.h"
+#include "../include/Inventory.h"
+#include "../include/MpmcQueue.h"
+#include "../include/PaymentGateway.h"
+#include "../include/Clock.h"
+#include "../include/LatencyStats.h"
+#include "../include/Metrics.h"
+#include "../include/Logger.h"
+#include "../include/LogEvents.h"
+#include "../include/Workload.h"
+#include "../include/Journal.h"
+#include "../include/TimingWheel.h"
+#include "../include/ObjectPool.h"
+#include "../include/Stage.h"
+#include "../include/Ledger.h"
+#ifdef CINEMA_COROUTINES
+#include "../include/Coroutine.h"
+#endif
 
-#define NUM_SEATS               72
+#define NUM_ROWS                6
+#define NUM_COLS                12
+#define NUM_SEATS               (NUM_ROWS * NUM_COLS)
+#define NUM_SHOWINGS            1
+#define NUM_WINDOWS             1       /*ticket offices of each showing*/
+#define MAX_WINDOWS             64
 #define NUM_SP                  3
 #define NUM_CLIENTS             30
+#define QUEUE_CAPACITY          1024
 #define MAX_REQUEST_TICKETS     6
 #define MAX_REQUEST_DRINK_POP   10
+#define ARRIVALS                "fixed"
+#define DISTRIBUTIONS           "uniform:1:5/uniform:1:9/uniform:1:9"   /*seats, drinks and popcorn of each client*/
 #define PAY_TO                  1 
 #define PAY_SP                  2 
+#define PAYMENT_WINDOW          1
+#define PAYMENT_LATENCY         300
+#define PAYMENT_RATIO           4       /*payments of tickets for each payment of food*/
+#define PAYMENT_STARVATION      2000    /*ms a payment can wait before it is sent whatever its type*/
+#define HOLD_TIMEOUT            5000    /*ms the seats are held waiting for the payment*/
+#define GROUP_SHOWINGS          3       /*showings booked by a group order*/
+#define MAX_GROUP_SHOWINGS      4
+#define BACKPRESSURE_DEPTH      256     /*clients queued for tickets before the arrivals wait*/
+#define WAITLIST_SIZE           16      /*clients that wait for released seats of each showing*/
+#define ADMIT_QUEUE             0
+#define ADMIT_WAIT              1
+#define ADMIT_REJECT            2
+#define HOLD_TICK               10      /*ms of each tick of the wheel that expires the holds*/
+#define ARRIVAL_RATE            2       /*clients that arrive each second*/
+#define TICKET_OFFICE_TIME      400     /*ms the ticket office spends with each client*/
+#define SALE_POINT_TIME         1300    /*ms the sale point spends with each client*/
+#define REPLENISH_TIME          900     /*ms the replenisher spends with each sale point*/
+#define NUM_STOCKERS            1       /*threads that replenish the sale points*/
+#define LOW_WATERMARK           30      /*percentage of the stock under which the sale point is replenished*/
+#define METRICS_PERIOD          1000    /*ms between two snapshots of the metrics*/
+#define JOURNAL_DURABILITY      JOURNAL_GROUP   /*the sales wait for the group commit of the journal*/
+#define JOURNAL_WINDOW          0       /*us the journal waits for more commits before a sync*/
+#define JOURNAL_SNAPSHOT        100000  /*records of the journal between two snapshots*/
+#define TICKET_PRICE            800     /*cents of each seat*/
+#define DRINK_PRICE             350     /*cents of each drink*/
+#define POPCORN_PRICE           500     /*cents of each popcorn*/
+
+/*The services are written once for both modes. In the coroutine mode (make coro) they are coroutines of 
+  the executor, AWAIT suspends them instead of blocking the thread and the queues and semaphores 
+  they wait for are the awaitable ones. In the threaded mode AWAIT is a plain call*/
+#ifdef CINEMA_COROUTINES
+#define SERVICE                 Task
+#define ASYNC(T)                Async<T>
+#define AWAIT(x)                (co_await (x))
+#define RETURN(x)               co_return x
+template <typename T> using Channel = AsyncQueue<T>; 
+typedef AsyncSemaphore          Semaphore; 
+#else
+#define SERVICE                 void
+#define ASYNC(T)                T
+#define AWAIT(x)                (x)
+#define RETURN(x)               return x
+template <typename T> using Channel = MpmcQueue<T>; 
+typedef WaitSlot                Semaphore; 
+#endif
+
+/*States of a client session*/
+#define CLIENT_REQUEST_TICKETS  1
+#define CLIENT_CHECK_TICKETS    2
+#define CLIENT_RECEIVE_FOOD     3
+
+/*Struct. Each group of fields written by different threads starts its own cache line*/
+struct alignas(64) InfoSalePoint {
+	int id;                                     /*id of sale point*/
+	int num_replenish;                          /*quantity of drinks and popcorn the sale point replenishes*/
+	int low_watermark;                          /*stock under which a replenishment is requested before it runs out*/
+	alignas(64) std::atomic<int> num_drinks{0}; /*quantity of drink that the point of sale has*/
+	std::atomic<int> num_popcorn{0};            /*quantity of popcorn that the point of sale has*/
+	std::atomic<bool> replenishing{false};      /*a request is already in the queue of the stockers, the next ones are merged*/
+	long requested_at;                          /*microseconds when the sale point asked the replenisher*/
+	Semaphore replenished{0};                   /*signalled by the stocker when the sale point has been replenished*/
+
+	InfoSalePoint(int id, int stock, int watermark): id(id), num_replenish(stock), low_watermark(watermark), num_drinks(stock), 
+	                                                 num_popcorn(stock), requested_at(0){}
+};
+
+/*Struct*/
+struct ClientSession {
+	int                 id;     /*id of client*/
+	int                 state;  /*next step the client does when it runs in the pool*/
+	MsgRequestTickets   mrt;    /*request to ticket office*/
+	MsgRequestSalePoint mrsp;   /*request to sale point*/
+
+	long                arrived_at; /*microseconds when the client arrived*/
+
+	ClientSession(int id, int sh, int ns, int nd, int np): id(id), state(CLIENT_REQUEST_TICKETS), mrt(id, ns, sh), mrsp(id, nd, np), arrived_at(0){}
+};
+
+/*Struct*/
+struct TicketPayment {
+	MsgRequestPayment   mrp;    /*payment of the tickets*/
+	MsgRequestTickets  *mrt;    /*request whose seats are held*/
+	unsigned long       hold;   /*timer of the hold, 0 if it doesn't expire*/
+
+	TicketPayment(MsgRequestTickets *mrt): mrp(mrt->id_client, PAY_TO), mrt(mrt), hold(0){}
+};
 
 /*Struct*/
-struct InfoSalePoint {
-	int id;              /*id of sale point*/
-	int num_drinks;      /*quantity of drink that the point of sale has*/
-	int num_popcorn;     /*quantity of popcorn that the point of sale has*/
-	int num_replenish;   /*quantity of drinks and popcorn the sale point replenishes*/
+struct PaymentWait {
+	MsgRequestPayment   mrp;            /*payment of the drinks and popcorn*/
+	Semaphore           paid{0};        /*signalled when the gateway answers*/
+	std::atomic<int>    owners{2};      /*the sale point and the gateway, the last one frees it*/
+
+	PaymentWait(int id, int type): mrp(id, type){}
 };
 
+/*Stages of the pipeline, ServiceRuntime says how their workers run in this build*/
+struct ServiceRuntime; 
+typedef Stage<MsgRequestTickets*, MsgRequestTickets*, ServiceRuntime>       TicketStage; 
+typedef Stage<MsgRequestSalePoint*, MsgRequestSalePoint*, ServiceRuntime>   SalePointStage; 
+typedef Stage<InfoSalePoint*, InfoSalePoint*, ServiceRuntime>               StockStage; 
+
 /*Globals variables*/
-int g_turn_tickets = 0;
-int g_turn_food    = 0; 
-int g_num_seats    = NUM_SEATS;
+Inventory           g_inventory;                    /*seats of every showing*/
+int                 g_num_showings  = NUM_SHOWINGS; /*showings on sale, each one in its own hall, option -p*/
+int                 g_num_windows   = NUM_WINDOWS;  /*ticket offices that sell each showing, option -O*/
+int                 g_num_clients   = NUM_CLIENTS;  /*clients of the run, option -c*/
+int                 g_num_workers   = 0;            /*workers of the pool, option -w (0 is one per core)*/
+int                 g_num_sp        = NUM_SP;       /*sale points, option -n*/
+int                 g_num_stockers  = NUM_STOCKERS; /*stockers, option -e*/
+int                 g_low_watermark = LOW_WATERMARK;/*percentage of the stock that triggers a replenishment, option -W*/
+double              g_arrival_rate  = ARRIVAL_RATE; /*clients that arrive each second, option -a (0 all at once)*/
+std::string         g_arrivals      = ARRIVALS;     /*arrival process, option -A*/
+std::string         g_distributions = DISTRIBUTIONS;/*distributions of the requests, option -D*/
+unsigned long       g_seed          = 0;            /*seed of the random numbers, option -x (0 takes one at random)*/
+Workload           *g_workload;                     /*generator of the clients*/
+int                 g_time_ticket_office = TICKET_OFFICE_TIME;  /*service time of the ticket office in ms, option -T*/
+int                 g_time_sale_point    = SALE_POINT_TIME;     /*service time of the sale point in ms, option -S*/
+int                 g_time_replenish     = REPLENISH_TIME;      /*service time of the replenisher in ms, option -R*/
+std::string         g_results_file;                 /*file where the results of the run are written, option -o*/
+std::string         g_metrics_file;                 /*file where the snapshots of the metrics are written, option -m*/
+int                 g_metrics_period = METRICS_PERIOD;  /*ms between two snapshots, option -M*/
+int                 g_log_level = LOG_DEBUG;        /*lines written, option -L*/
+int                 g_log_mode  = LOG_ASYNC;        /*lines written by the thread that logs them or by the writer, options -g and -B*/
+std::string         g_log_file;                     /*file of the binary log, option -B*/
+Logger              g_logger(g_log_events); 
+std::chrono::steady_clock::time_point g_start;      /*start of the run*/
+double              g_time_scale    = 1.0;          /*factor applied to every delay, option -s (0 disables them)*/
+bool                g_virtual_time  = false;        /*run on the virtual clock, option -v*/
+Clock              *g_clock;                        /*clock of the delays and the times*/
+VirtualClock       *g_virtual       = nullptr;      /*the same clock when it is virtual*/
+ThreadPool         *g_pool;                         /*pool that runs the client sessions*/
+int                 g_payment_window        = PAYMENT_WINDOW;   /*authorizations in flight in the payment gateway, option -k*/
+int                 g_payment_latency       = PAYMENT_LATENCY;  /*mean latency of the payment processor in ms, option -l*/
+int                 g_payment_distribution  = LATENCY_CONSTANT; /*distribution of the latency, option -d (0 constant, 1 uniform, 2 exponential)*/
+double              g_payment_failures      = 0;                /*probability that a payment is rejected, option -f*/
+int                 g_payment_ratio         = PAYMENT_RATIO;    /*weight of the tickets against the food in the payment scheduler, option -r*/
+int                 g_payment_starvation    = PAYMENT_STARVATION; /*starvation bound of the payment scheduler in ms, option -b*/
+PaymentGateway     *g_gateway;                      /*gateway to the payment processor*/
+int                 g_hold_timeout          = HOLD_TIMEOUT;     /*ms a hold waits for its payment before it is abandoned, option -t (0 never)*/
+std::atomic<int>    g_holds_abandoned(0);                       /*holds released by the wheel because the payment didn't arrive in time*/
+TimingWheel         g_holds(HOLD_TICK * 1000L);                 /*timer of each hold waiting for its payment*/
+double              g_group_share           = 0;                /*fraction of the clients that are a group order, option -y*/
+int                 g_group_showings        = GROUP_SHOWINGS;   /*showings of each group order, option -Y*/
+std::atomic<int>    g_groups(0);                                /*group orders of the run*/
+std::atomic<int>    g_groups_sold(0);                           /*group orders whose showings were all sold*/
+bool                g_admission             = true;             /*clients that can't be served are refused or wait before the queue, option -C*/
+int                 g_backpressure          = BACKPRESSURE_DEPTH; /*clients queued for tickets before the arrivals wait, option -q (0 never)*/
+int                 g_waitlist_size         = WAITLIST_SIZE;    /*bound of the waitlist of each showing, option -H*/
+std::atomic<int>    g_admitted(0);                              /*clients queued for tickets that haven't been answered*/
+std::atomic<bool>   g_arrivals_blocked(false);                  /*the arrivals wait for the queue to go down*/
+std::atomic<int>    g_sold_out(0);                              /*clients refused when they arrive*/
+std::atomic<int>    g_waitlisted(0);                            /*clients that have waited in a waitlist*/
+std::atomic<int>    g_promoted(0);                              /*clients of a waitlist sent to the ticket office*/
+std::atomic<int>    g_backpressure_waits(0);                    /*times the arrivals have waited for the queue*/
+std::atomic<bool>   g_holds_closed(false);                      /*the service that expires the holds ends*/
+std::string         g_journal_file;                 /*journal of the sales, option -j (none if empty)*/
+int                 g_journal_durability = JOURNAL_DURABILITY;  /*0 async, 1 group commit, 2 sync each commit, option -J*/
+long                g_journal_window     = JOURNAL_WINDOW;      /*us of the group commit, option -G*/
+long                g_journal_snapshot   = JOURNAL_SNAPSHOT;    /*records between two snapshots, option -Q (0 never)*/
+Journal             g_journal;                      /*seats sold, payments and stock changes*/
+Ledger              g_ledger;                       /*paid sales by columns, for the revenue queries*/
 
 /*Messages queue*/
-std::queue<std::thread>                 g_queue_tickets;            /*queue of clients to buy tickets*/
-std::queue<std::thread>                 g_queue_clients_out;        /*queue of clients that not buy tickets*/
-std::queue<std::thread>                 g_queue_cinema;             /*queue representing cinema*/
-std::queue<std::thread>                 g_queue_drinkpop;           /*queue where the client go to inside of cinema to buy drinks and popcorn*/
-std::queue<MsgRequestTickets*>          g_queue_request_tickets;    /*queue to request tickets*/
-std::queue<MsgRequestSalePoint*>        g_queue_request_sp;         /*queue to request sale point*/
-std::queue<InfoSalePoint*>              g_queue_request_stock;      /*queue to request thread stocker*/
-std::priority_queue<MsgRequestPayment*> g_queue_request_payment;    /*queue to request pay*/
+std::queue<ClientSession*>              g_queue_tickets;            /*queue of clients to buy tickets*/
+std::vector<std::deque<ClientSession*>> g_waitlists;                /*clients of each showing waiting for released seats*/
+std::mutex                              g_mutex_waitlists;          /*mutex of the waitlists*/
+std::queue<int>                         g_queue_clients_out;        /*queue of clients that not buy tickets*/
+std::queue<int>                         g_queue_cinema;             /*queue representing cinema*/
+std::vector<InfoSalePoint*>             g_sale_points;              /*stock of each sale point*/
+TicketStage                            *g_stage_tickets;            /*ticket offices of every showing, the ones of a showing are together*/
+SalePointStage                         *g_stage_sale_points;        /*sale points, each one steals the clients of the others when it is idle*/
+StockStage                             *g_stage_stock;              /*stockers that replenish the sale points*/
+
+/*Latencies of each phase*/
+LatencyStats                            g_lat_ticket_queue("ticket_queue");         /*wait in the queue of the ticket office*/
+LatencyStats                            g_lat_ticket_office("ticket_office");       /*ticket office and payment of the tickets*/
+LatencyStats                            g_lat_sale_point_queue("sale_point_queue"); /*wait in the queue of the sale points*/
+LatencyStats                            g_lat_sale_point("sale_point");             /*sale point and payment of the food*/
+LatencyStats                            g_lat_replenisher("replenisher_wait");      /*since a sale point asks for stock until it is replenished*/
+LatencyStats                            g_lat_payment("payment");                   /*payment gateway*/
+LatencyStats                            g_lat_refused("refused");                   /*since a client arrives until it knows there are no tickets*/
+LatencyStats                           *g_phases[] = {&g_lat_ticket_queue, &g_lat_ticket_office, &g_lat_sale_point_queue, 
+                                                      &g_lat_sale_point, &g_lat_replenisher, &g_lat_payment, &g_lat_refused}; 
+
+/*Metrics, always recorded*/
+Metrics                                 g_metrics; 
+int                                     g_phase_metrics[sizeof(g_phases) / sizeof(g_phases[0])]; /*histogram of each phase of g_phases*/
+int                                     g_m_seats_sold;             /*seats confirmed*/
+int                                     g_m_seats_released;         /*held seats released because the payment failed or was abandoned*/
+int                                     g_m_tickets_refused;        /*requests of tickets without enough seats*/
+int                                     g_m_drinks_sold;            /*drinks given to the clients*/
+int                                     g_m_popcorn_sold;           /*popcorn given to the clients*/
+int                                     g_m_stock_returned;         /*drinks and popcorn back in the stock after a rejected payment*/
+int                                     g_m_payments_refunded;      /*payments approved after their hold expired*/
+int                                     g_m_replenishments;         /*sale points replenished*/
+int                                     g_m_replenish_merged;       /*requests of replenishment merged with one in the queue*/
+int                                     g_m_stock_restocked;        /*drinks and popcorn put by the stockers*/
+int                                     g_m_stalls;                 /*clients that waited for a replenishment*/
+int                                     g_m_stall;                  /*time a client waits for a replenishment*/
+int                                     g_m_clients_finished;       /*clients that have ended*/
+int                                     g_m_service_ticket_office;  /*time the ticket office spends with a client without the payment*/
+int                                     g_m_wait_ticket_office;     /*time the ticket office waits for clients*/
+int                                     g_m_wait_sale_point;        /*time a sale point waits for clients*/
+int                                     g_m_wait_sale_point_payment;/*time a sale point waits for the payment*/
+int                                     g_m_wait_replenisher;       /*time the replenisher waits for requests*/
+int                                     g_m_wait_manager;           /*time the manager waits for clients*/
+int                                     g_m_journal_commit;         /*time a commit waits for the journal*/
 
 /*Semaphores*/
-SemCounter                              g_sem_seats(1);             /*sem to control seats*/
-SemCounter                              g_sem_payment(1);           /*sem to control payment*/
-SemCounter                              g_sem_replenisher(1);       /*sem to control replenisher*/
-SemCounter                              g_sem_sale_point(0);        /*sem to control sale point*/
-std::mutex                              g_sem_tickets;              /*sem to wait tickets*/
-std::mutex                              g_sem_toffice;              /*sem to wake ticket office*/
-std::mutex                              g_sem_manager_tickets;      /*sem to manager send a new turn in ticket office*/
-std::mutex                              g_sem_drink_popcorn;        /*sem to wait drinks and popcorns*/
-std::mutex                              g_sem_turn_tickets;         /*sem to control the turn in ticket office*/
-std::mutex                              g_sem_turn_food;            /*sem to control the turn in sale point*/
-std::mutex                              g_sem_mutex_access_payment; /*sem to control the access to payment request queue*/
-std::mutex                              g_sem_mutex_access_sp;      /*sem to control the access to sale points request queue*/
-std::mutex                              g_sem_mutex_payment;        /*sem to control section critical in payment system*/
-std::mutex                              g_sem_wait_payment;         /*sem to wait confirmation of tickets payment*/
-
-/*Condition variable*/
-std::condition_variable                 g_cv_ticket_office;         /*condition variable to notify the turn of ticket office*/
-std::condition_variable                 g_cv_drinks_popcorn;        /*condition variable to notify the turn of buy drinks and popcorn*/
-std::condition_variable                 g_cv_receive_food;          /*condition variable to notify that the client has received drinks and popcorn*/
-std::condition_variable                 g_cv_payment;               /*condition variable to notify if the client has paid tickets*/
+Semaphore                               g_sem_clients_arrived(0);   /*sem to wake the manager when a client arrives*/
+Semaphore                               g_sem_holds(0);             /*sem to wake the service of the holds when the wheel isn't empty*/
+Semaphore                               g_sem_admission(0);         /*sem to wake the arrivals when the queue of tickets goes down*/
+WaitSlot                                g_sem_clients_done(0);      /*sem to count the clients that have finished*/
+std::mutex                              g_sem_mutex_clients;        /*sem to control the access to the queues of clients*/
+
+/*Pools of the requests*/
+bool                                    g_pooled = true;            /*the requests come from the pools, option -P (0 new and delete)*/
+ObjectPool<ClientSession>               g_sessions;                 /*session and requests of each client*/
+ObjectPool<TicketPayment>               g_ticket_payments;          /*payment of the tickets while its seats are held*/
+ObjectPool<PaymentWait>                 g_payment_waits;            /*payment a sale point waits for*/
+
+/*Services*/
+#ifdef CINEMA_COROUTINES
+Executor                               *g_executor;                 /*runs the clients and the services in the workers of the pool*/
+WaitSlot                                g_sem_services_done(0);     /*sem to count the services that have ended*/
+int                                     g_num_services = 0; 
+#else
+std::vector<std::thread>                g_services;                 /*thread of each service*/
+#endif
 
 /*Functions declaration*/
-int                  generateRandomNumber(int lim); 
+ASYNC(void)          sleepFor(long us); 
+ASYNC(void)          simulateDelay(int ms); 
+long                 timestamp(); 
+int                  queueCapacity(); 
+template <typename T> 
+void                 sendMessage(MpmcQueue<T> &queue, T msg); 
+template <typename T> 
+T                    receiveMessage(MpmcQueue<T> &queue, int metric = -1); 
+void                 waitSignal(WaitSlot &sem, int metric = -1); 
+void                 sendSignal(WaitSlot &sem); 
+#ifdef CINEMA_COROUTINES
+template <typename T> 
+void                 sendMessage(AsyncQueue<T> &queue, T msg); 
+template <typename T> 
+Async<T>             receiveMessage(AsyncQueue<T> &queue, int metric = -1); 
+Async<void>          waitSignal(AsyncSemaphore &sem, int metric = -1); 
+void                 sendSignal(AsyncSemaphore &sem); 
+#endif
+void                 startService(std::function<SERVICE()> service); 
+template <typename S> 
+SERVICE              stageWorker(S *stage, unsigned w); 
+void                 endService(); 
+void                 joinServices(); 
+void                 parseArguments(int argc, char *argv[]); 
 void                 signalHandler(int signal); 
 void                 messageWelcome(); 
-void                 showInfo(); 
-void                 blockSem();
-int                  priorityAssignment();
-void                 createClients();  
-void                 client(int id_client); 
-MsgRequestTickets    buyTickets(int id_client);
-void                 checkTicketsClient(int id_client, MsgRequestTickets mrt);
-void                 ticketOffice();
-void                 checkNumTickets(MsgRequestTickets *mrt);
-void                 buyDrinksPopcorn(int id_client);
-void                 checkPaymentTicketOffice(MsgRequestPayment mrp, MsgRequestTickets *mrt); 
-void                 salePoint(InfoSalePoint &sp); 
-void                 checkNumDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp);
-void                 requestReplenisher(MsgRequestSalePoint *mrsp, InfoSalePoint &sp);
-void                 checkPaymentSalePoint(MsgRequestSalePoint *mrsp, InfoSalePoint &sp);
-void                 replenish();
-void                 paymentSystem();
-void                 manager(); 
-
-/******************************************************
- * Function name:    generateRandomNumber
- * Date created:     4/4/2020
+void                 showSummary(std::chrono::steady_clock::duration elapsed); 
+void                 writeResults(std::chrono::steady_clock::duration elapsed); 
+void                 registerMetrics(); 
+void                 recordPhase(LatencyStats &phase, long us); 
+std::string          seatNames(MsgRequestTickets *mrt); 
+void                 openShowings(); 
+void                 openStages(); 
+void                 openJournal(); 
+void                 journal(JournalRecord *records, int n); 
+void                 journal(JournalRecord *records, int n, std::function<void()> then); 
+SERVICE              createClients();  
+ASYNC(void)          waitBackpressure(); 
+int                  admission(MsgRequestTickets *mrt, int &showing); 
+void                 admitClient(ClientSession *cs); 
+void                 queueClient(ClientSession *cs); 
+void                 refuseClient(ClientSession *cs); 
+void                 promoteWaitlist(MsgRequestTickets *mrt); 
+void                 ticketsAnswered(); 
+#ifdef CINEMA_COROUTINES
+Task                 client(ClientSession *cs); 
+#else
+void                 client(ClientSession *cs); 
+void                 buyTickets(ClientSession *cs);
+void                 checkTicketsClient(ClientSession *cs);
+void                 buyDrinksPopcorn(ClientSession *cs);
+#endif
+void                 resumeClient(ClientSession *cs); 
+void                 finishClient(ClientSession *cs); 
+ASYNC(MsgRequestTickets*) ticketOffice(MsgRequestTickets *mrt, unsigned window);
+ASYNC(bool)          checkNumTickets(MsgRequestTickets *mrt);
+bool                 holdTickets(MsgRequestTickets *mrt); 
+void                 confirmTickets(MsgRequestTickets *mrt); 
+void                 releaseTickets(MsgRequestTickets *mrt); 
+int                  countSeats(MsgRequestTickets *mrt); 
+void                 ledgerTickets(MsgRequestTickets *mrt); 
+void                 checkPaymentTicketOffice(TicketPayment *tp); 
+void                 endTicketPayment(TicketPayment *tp, bool sold, bool abandoned); 
+bool                 holdsExpire(); 
+unsigned long        armHold(MsgRequestTickets *mrt); 
+void                 expireHold(void *data); 
+SERVICE              expireHolds(); 
+ASYNC(MsgRequestSalePoint*) salePoint(MsgRequestSalePoint *mrsp, unsigned id); 
+ASYNC(void)          checkNumDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp);
+void                 requestReplenisher(InfoSalePoint &sp);
+bool                 takeStock(std::atomic<int> &stock, int n); 
+bool                 takeDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp); 
+ASYNC(void)          checkPaymentSalePoint(MsgRequestSalePoint *mrsp, InfoSalePoint &sp);
+ASYNC(InfoSalePoint*) replenish(InfoSalePoint *sp, unsigned id); 
+ASYNC(bool)          paymentSystem(int id_client, int type);
+void                 releasePaymentWait(PaymentWait *pw);
+void                 paymentSystem(MsgRequestPayment *mrp, std::function<void()> on_done);
+void                 showPayment(MsgRequestPayment *mrp);
+SERVICE              manager(); 
+void                 stopServices(); 
+template <typename S> 
+void                 showStage(S *stage, long now); 
+template <typename S> 
+void                 writeStage(std::ofstream &out, S *stage, long now, bool last); 
+void                 showRevenue(std::string name, const std::vector<LedgerGroup> &groups); 
+
+/*Struct. Queues, semaphores and results of the services, a stage runs its workers as the rest of the services*/
+struct ServiceRuntime {
+	template <typename T> using Queue  = Channel<T>; 
+	template <typename T> using Result = ASYNC(T); 
+	typedef Semaphore Wakeup; 
+
+	static long now(){ return timestamp(); }
+	template <typename Q, typename T> 
+	static void send(Q &queue, T msg){ sendMessage(queue, msg); }
+	static void signal(Semaphore &sem){ sendSignal(sem); }
+};
+
+/******************************************************
+ * Function name:    sleepFor
+ * Date created:     17/10/2026
+ * Input arguments:  microseconds of the delay
+ * Purpose:          Sleep the service. The clock multiplies the delay by g_time_scale or, in virtual time, 
+ *                   it only advances the time. A coroutine is suspended and the worker runs other ones
+ * 
+ ******************************************************/
+ASYNC(void) sleepFor(long us){
+#ifdef CINEMA_COROUTINES
+    co_await g_executor->sleepFor(us); 
+#else
+    g_clock->sleepFor(us); 
+#endif
+}
+
+/******************************************************
+ * Function name:    simulateDelay
+ * Date created:     17/10/2026
+ * Input arguments:  milliseconds of the delay
+ * Purpose:          Sleep the service to simulate the service time
+ * 
+ ******************************************************/
+ASYNC(void) simulateDelay(int ms){
+    AWAIT(sleepFor(ms * 1000L)); 
+}
+
+/******************************************************
+ * Function name:    timestamp
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Microseconds since the start of the run to measure the latencies. 
+ *                   In virtual time it is the time of the clock
+ * 
+ ******************************************************/
+long timestamp(){
+    if(g_virtual != nullptr){
+        return g_virtual->now(); 
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_start).count(); 
+}
+
+/******************************************************
+ * Function name:    queueCapacity
+ * Date created:     17/10/2026
  * Input arguments: 
- * Purpose:          Generate a random number 
+ * Purpose:          Capacity of the queues of requests. In virtual time they hold every client because 
+ *                   a client of the pool waiting on a full queue would stop the time
+ * 
+ ******************************************************/
+int queueCapacity(){
+    return (g_virtual != nullptr && g_num_clients > QUEUE_CAPACITY) ? g_num_clients : QUEUE_CAPACITY; 
+}
+
+/******************************************************
+ * Function name:    sendMessage
+ * Date created:     17/10/2026
+ * Input arguments:  queue and message
+ * Purpose:          Push the message, in virtual time it waits through the clock and wakes the receivers
+ * 
+ ******************************************************/
+template <typename T> 
+void sendMessage(MpmcQueue<T> &queue, T msg){
+    if(g_virtual == nullptr){
+        queue.push(msg); 
+        return; 
+    }
+    g_virtual->waitFor(&queue, [&queue, msg](){ return queue.try_push(msg); }); 
+    g_virtual->notify(&queue); 
+}
+
+/******************************************************
+ * Function name:    receiveMessage
+ * Date created:     17/10/2026
+ * Input arguments:  queue and histogram of the wait
+ * Purpose:          Pop a message, in virtual time it waits through the clock and wakes the senders
+ * 
+ ******************************************************/
+template <typename T> 
+T receiveMessage(MpmcQueue<T> &queue, int metric){
+    long start = timestamp(); 
+    T msg; 
+    if(g_virtual == nullptr){
+        msg = queue.pop(); 
+    }else{
+        g_virtual->waitFor(&queue, [&queue, &msg](){ return queue.try_pop(msg); }); 
+        g_virtual->notify(&queue); 
+    }
+    g_metrics.observe(metric, timestamp() - start); 
+    return msg; 
+}
+
+/******************************************************
+ * Function name:    waitSignal
+ * Date created:     17/10/2026
+ * Input arguments:  semaphore and histogram of the wait
+ * Purpose:          Wait on the semaphore, in virtual time through the clock
+ * 
+ ******************************************************/
+void waitSignal(WaitSlot &sem, int metric){
+    long start = timestamp(); 
+    if(g_virtual == nullptr){
+        sem.wait(); 
+    }else{
+        g_virtual->waitFor(&sem, [&sem](){ return sem.try_wait(); }); 
+    }
+    g_metrics.observe(metric, timestamp() - start); 
+}
+
+/******************************************************
+ * Function name:    sendSignal
+ * Date created:     17/10/2026
+ * Input arguments:  semaphore
+ * Purpose:          Signal the semaphore, it wakes only the thread that waits for it. In virtual time it wakes 
+ *                   the waiters through the clock
+ * 
+ ******************************************************/
+void sendSignal(WaitSlot &sem){
+    sem.signal(); 
+    if(g_virtual != nullptr){
+        g_virtual->notify(&sem); 
+    }
+}
+
+#ifdef CINEMA_COROUTINES
+/******************************************************
+ * Function name:    sendMessage
+ * Date created:     17/10/2026
+ * Input arguments:  queue of coroutines and message
+ * Purpose:          Push the message, the coroutine that waits for it is resumed by the executor
+ * 
+ ******************************************************/
+template <typename T> 
+void sendMessage(AsyncQueue<T> &queue, T msg){
+    queue.push(msg); 
+}
+
+/******************************************************
+ * Function name:    receiveMessage
+ * Date created:     17/10/2026
+ * Input arguments:  queue of coroutines and histogram of the wait
+ * Purpose:          Pop a message, the coroutine is suspended while the queue is empty
+ * 
+ ******************************************************/
+template <typename T> 
+Async<T> receiveMessage(AsyncQueue<T> &queue, int metric){
+    long start = timestamp(); 
+    T msg = co_await queue.pop(); 
+    g_metrics.observe(metric, timestamp() - start); 
+    co_return msg; 
+}
+
+/******************************************************
+ * Function name:    waitSignal
+ * Date created:     17/10/2026
+ * Input arguments:  semaphore of coroutines and histogram of the wait
+ * Purpose:          Wait on the semaphore, the coroutine is suspended
+ * 
+ ******************************************************/
+Async<void> waitSignal(AsyncSemaphore &sem, int metric){
+    long start = timestamp(); 
+    co_await sem.wait(); 
+    g_metrics.observe(metric, timestamp() - start); 
+}
+
+/******************************************************
+ * Function name:    sendSignal
+ * Date created:     17/10/2026
+ * Input arguments:  semaphore of coroutines
+ * Purpose:          Signal the semaphore, the coroutine that waits for it is resumed by the executor
+ * 
+ ******************************************************/
+void sendSignal(AsyncSemaphore &sem){
+    sem.signal(); 
+}
+#endif
+
+/******************************************************
+ * Function name:    startService
+ * Date created:     17/10/2026
+ * Input arguments:  function of the service
+ * Purpose:          Start the service in its own thread or, in the coroutine mode, in the executor
+ * 
+ ******************************************************/
+void startService(std::function<SERVICE()> service){
+#ifdef CINEMA_COROUTINES
+    g_num_services++; 
+    g_executor->spawn(service()); 
+#else
+    g_clock->enter(); 
+    g_services.push_back(std::thread(service)); 
+#endif
+}
+
+/******************************************************
+ * Function name:    endService
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          The service has ended, its thread leaves the simulation
+ * 
+ ******************************************************/
+void endService(){
+#ifdef CINEMA_COROUTINES
+    sendSignal(g_sem_services_done); 
+#else
+    g_clock->leave(); 
+#endif
+}
+
+/******************************************************
+ * Function name:    joinServices
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Wait until every service has ended
+ * 
+ ******************************************************/
+void joinServices(){
+#ifdef CINEMA_COROUTINES
+    for(int i = 0; i < g_num_services; i++){
+        g_sem_services_done.wait(); 
+    }
+#else
+    for(unsigned i = 0; i < g_services.size(); i++){
+        g_services[i].join(); 
+    }
+#endif
+}
+
+/******************************************************
+ * Function name:    stageWorker
+ * Date created:     17/10/2026
+ * Input arguments:  stage and worker
+ * Purpose:          Service of a worker of the stage. It takes the messages of its queue, or steals them, and 
+ *                   sleeps after checking again the queues, a sender that arrives meanwhile sees it idle and wakes it. 
+ *                   The output of each message goes on through the stage, an empty message ends the worker
+ * 
+ ******************************************************/
+template <typename S> 
+SERVICE stageWorker(S *stage, unsigned w){
+    typename S::Item item; 
+    while(true){
+        if(!stage->take(w, item)){
+            stage->idle(w, true); 
+            if(!stage->take(w, item)){
+                AWAIT(waitSignal(stage->wakeup(w), stage->getIdleMetric())); 
+                continue; 
+            }
+            stage->idle(w, false); 
+        }
+        if(item.msg == nullptr){ /*The worker ends*/
+            break; 
+        }
+        try{
+            long start = timestamp(); 
+            typename S::output_type out = AWAIT(stage->process(item.msg, w)); 
+            stage->record(start - item.at, timestamp() - start); 
+            if(out != nullptr){
+                stage->emit(out); 
+            }
+        }catch(std::exception &e){
+            stage->fail(w); 
+        }
+    }
+    endService(); 
+}
+
+/******************************************************
+ * Function name:    parseArguments
+ * Date created:     17/10/2026
+ * Input arguments:  arguments of the program
+ * Purpose:          Read the options -c <clients> -w <workers> -s <time scale> -p <showings> and the options 
+ *                   of the payment gateway -k <window> -l <latency ms> -d <distribution> -f <failure rate> 
+ *                   -r <tickets per food payment> -b <starvation bound ms>, the timeout of the holds -t <ms> 
+ *                   and -v to run in virtual time. For the benchmarks -n <sale points> -a <arrival rate> 
+ *                   -T/-S/-R <service time ms> of the ticket office, the sale point and the replenisher 
+ *                   and -o <file> to write the results. -m <file> writes the metrics each -M <ms>. 
+ *                   -L <level> of the lines, -g <0|1> synchronous or asynchronous log and -B <file> binary log. 
+ *                   -e <stockers> and -W <percentage> of the stock that triggers a replenishment. 
+ *                   -A fixed|poisson|bursty:factor:on_s:off_s|trace:file.csv arrivals, -D <seats>/<drinks>/<popcorn> 
+ *                   distributions (uniform:min:max, fixed:n, poisson:mean or geometric:p) and -x <seed>. 
+ *                   -j <file> journal of the sales, -J <0|1|2> async, group or sync commits, -G <us> window of the 
+ *                   group commit and -Q <records> between two snapshots. -P 0 allocates each request instead of the pools. 
+ *                   -y <fraction> of the clients that book -Y <showings> at once and -O <ticket offices> of each showing. 
+ *                   -C <0|1> admission control, -q <clients> queued for tickets before the arrivals wait and 
+ *                   -H <clients> of the waitlist of each showing
  * 
  ******************************************************/
-int generateRandomNumber(int lim){ return (rand()%(lim-1))+1; }
+void parseArguments(int argc, char *argv[]){
+    int opt; 
+    while((opt = getopt(argc, argv, "c:w:s:p:k:l:d:f:r:b:t:vn:a:T:S:R:o:m:M:L:g:B:e:W:A:D:x:j:J:G:Q:P:y:Y:O:C:q:H:")) != -1){
+        switch(opt){
+            case 'c':
+                g_num_clients = std::atoi(optarg); 
+                break; 
+            case 'w':
+                g_num_workers = std::atoi(optarg); 
+                break; 
+            case 's':
+                g_time_scale  = std::atof(optarg); 
+                break; 
+            case 'p':
+                g_num_showings = std::atoi(optarg); 
+                break; 
+            case 'k':
+                g_payment_window = std::atoi(optarg); 
+                break; 
+            case 'l':
+                g_payment_latency = std::atoi(optarg); 
+                break; 
+            case 'd':
+                g_payment_distribution = std::atoi(optarg); 
+                break; 
+            case 'f':
+                g_payment_failures = std::atof(optarg); 
+                break; 
+            case 'r':
+                g_payment_ratio = std::atoi(optarg); 
+                break; 
+            case 'b':
+                g_payment_starvation = std::atoi(optarg); 
+                break; 
+            case 't':
+                g_hold_timeout = std::atoi(optarg); 
+                break; 
+            case 'v':
+                g_virtual_time = true; 
+                break; 
+            case 'n':
+                g_num_sp = std::atoi(optarg); 
+                break; 
+            case 'a':
+                g_arrival_rate = std::atof(optarg); 
+                break; 
+            case 'T':
+                g_time_ticket_office = std::atoi(optarg); 
+                break; 
+            case 'S':
+                g_time_sale_point = std::atoi(optarg); 
+                break; 
+            case 'R':
+                g_time_replenish = std::atoi(optarg); 
+                break; 
+            case 'o':
+                g_results_file = optarg; 
+                break; 
+            case 'm':
+                g_metrics_file = optarg; 
+                break; 
+            case 'M':
+                g_metrics_period = std::atoi(optarg); 
+                break; 
+            case 'L':
+                g_log_level = std::atoi(optarg); 
+                break; 
+            case 'g':
+                g_log_mode = std::atoi(optarg) == 0 ? LOG_SYNC : LOG_ASYNC; 
+                break; 
+            case 'B':
+                g_log_file = optarg; 
+                g_log_mode = LOG_BINARY; 
+                break; 
+            case 'e':
+                g_num_stockers = std::max(1, std::atoi(optarg)); 
+                break; 
+            case 'W':
+                g_low_watermark = std::atoi(optarg); 
+                break; 
+            case 'A':
+                g_arrivals = optarg; 
+                break; 
+            case 'D':
+                g_distributions = optarg; 
+                break; 
+            case 'x':
+                g_seed = std::strtoul(optarg, nullptr, 10); 
+                break; 
+            case 'j':
+                g_journal_file = optarg; 
+                break; 
+            case 'J':
+                g_journal_durability = std::atoi(optarg); 
+                break; 
+            case 'G':
+                g_journal_window = std::atol(optarg); 
+                break; 
+            case 'Q':
+                g_journal_snapshot = std::atol(optarg); 
+                break; 
+            case 'P':
+                g_pooled = std::atoi(optarg) != 0; 
+                break; 
+            case 'y':
+                g_group_share = std::atof(optarg); 
+                break; 
+            case 'Y':
+                g_group_showings = std::atoi(optarg); 
+                break; 
+            case 'O':
+                g_num_windows = std::atoi(optarg); 
+                break; 
+            case 'C':
+                g_admission = std::atoi(optarg) != 0; 
+                break; 
+            case 'q':
+                g_backpressure = std::atoi(optarg); 
+                break; 
+            case 'H':
+                g_waitlist_size = std::max(0, std::atoi(optarg)); 
+                break; 
+            default:
+                std::cout << BOLDWHITE << "Usage: " << argv[0] << " [-c clients] [-w workers] [-s time scale] [-p showings] [-k window] [-l latency] [-d distribution] [-f failure rate] [-r ratio] [-b starvation bound] [-t hold timeout] [-v] [-n sale points] [-a arrival rate] [-T|-S|-R service ms] [-o results file] [-m metrics file] [-M metrics period] [-L log level] [-g log mode] [-B binary log] [-e stockers] [-W low-watermark %] [-A arrivals] [-D distributions] [-x seed] [-j journal] [-J durability] [-G group commit us] [-Q snapshot records] [-P 0|1] [-y group share] [-Y group showings] [-O ticket offices] [-C 0|1] [-q backpressure depth] [-H waitlist size]" << RESET << std::endl; 
+                std::exit(EXIT_FAILURE); 
+        }
+    }
+}
 
 /******************************************************
  * Function name:    signalHandler
  * Date created:     11/4/2020
  * Input arguments: 
- * Purpose:          Signal Handler to show a message when the user uses CTRL + C 
+ * Purpose:          Signal Handler to show a message when the user uses CTRL + C. 
+ *                   The journal is written to the disk before the program is killed
  * 
  ******************************************************/
-void signalHandler(int signal){
+void signalHandler(int){
+    g_journal.syncFile(); 
     std::cout << BOLDWHITE << "[HANDLER] It has been received the signal CTRL+C. The program ended...\n" << RESET << std::endl; 
     kill(getpid(), SIGKILL); 
     std::exit(EXIT_SUCCESS); 
@@ -139,81 +842,746 @@ void messageWelcome(){
 }
 
 /******************************************************
- * Function name:    blockSem
- * Date created:     16/4/2020
- * Input arguments:  
- * Purpose:          Block semaphores 
+ * Function name:    showSummary
+ * Date created:     17/10/2026
+ * Input arguments:  time of the run
+ * Purpose:          Show the throughput of the run, the wait of each type of payment and the peak of memory used by the process
  * 
  ******************************************************/
-void blockSem(){
-    g_sem_tickets.lock();             
-    g_sem_toffice.lock();                            
-    g_sem_manager_tickets.lock();    
-    g_sem_sale_point.wait();             
-    g_sem_payment.wait(); 
-    g_sem_replenisher.wait();    
+void showSummary(std::chrono::steady_clock::duration elapsed){
+    struct rusage usage; 
+    getrusage(RUSAGE_SELF, &usage); 
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / 1e6; 
+
+    std::cout << BOLDWHITE << "[SUMMARY] clients=" << g_num_clients << " workers=" << g_pool->size() 
+              << " clock=" << (g_virtual != nullptr ? "virtual" : "real") << " time_scale=" << g_time_scale << " seconds=" << seconds 
+              << " simulated_seconds=" << g_clock->now() / 1e6 
+              << " clients/s=" << (seconds > 0 ? g_num_clients / seconds : 0) 
+              << " tickets/s=" << (seconds > 0 ? g_inventory.getSold() / seconds : 0) << " sale_points=" << g_num_sp 
+              << " stockers=" << g_num_stockers << " low_watermark=" << g_low_watermark << " stalls=" << g_metrics.getCounter(g_m_stalls) 
+              << " replenishments=" << g_metrics.getCounter(g_m_replenishments) << " replenish_merged=" << g_metrics.getCounter(g_m_replenish_merged) 
+              << " showings=" << g_num_showings << " ticket_offices=" << g_num_windows << " arrivals=" << g_arrivals << " seed=" << g_seed << " tickets_sold=" << g_inventory.getSold() 
+               << " holds_abandoned=" << g_holds_abandoned << " group_orders=" << g_groups << " groups_sold=" << g_groups_sold 
+              << " admission=" << g_admission << " sold_out=" << g_sold_out << " waitlisted=" << g_waitlisted << " promoted=" << g_promoted 
+              << " backpressure_waits=" << g_backpressure_waits << " in_cinema=" << g_queue_cinema.size() << " out=" << g_queue_clients_out.size() 
+              << " payment_window=" << g_gateway->getWindow() << " max_in_flight=" << g_gateway->getMaxInFlight() 
+              << " payments_approved=" << g_gateway->getApproved() << " payments_rejected=" << g_gateway->getRejected() << " payments_refunded=" << g_metrics.getCounter(g_m_payments_refunded) 
+              << " payment_ratio=" << g_payment_ratio << " payments_starved=" << g_gateway->getStarved() 
+              << " wait_tickets_p50_us=" << g_gateway->getWaitPercentile(PAY_TO, 50) << " wait_tickets_p99_us=" << g_gateway->getWaitPercentile(PAY_TO, 99) 
+              << " wait_food_p50_us=" << g_gateway->getWaitPercentile(PAY_SP, 50) << " wait_food_p99_us=" << g_gateway->getWaitPercentile(PAY_SP, 99) 
+              << " journal_commits=" << g_journal.getCommits() << " journal_syncs=" << g_journal.getSyncs() 
+              << " journal_snapshots=" << g_journal.getSnapshots() 
+              << " pooled=" << g_pooled << " session_slabs=" << g_sessions.getSlabs() 
+              << " context_switches=" << usage.ru_nvcsw + usage.ru_nivcsw << " csw_per_client=" << (usage.ru_nvcsw + usage.ru_nivcsw) / static_cast<double>(g_num_clients) 
+              << " peak_rss_kb=" << usage.ru_maxrss << RESET << std::endl; 
+    for(LatencyStats *phase : g_phases){
+        std::cout << BOLDWHITE << "[LATENCY] " << phase->getName() << " count=" << phase->getCount() 
+                  << " p50_us=" << phase->getPercentile(50) << " p90_us=" << phase->getPercentile(90) 
+                  << " p99_us=" << phase->getPercentile(99) << " max_us=" << phase->getMax() << RESET << std::endl; 
+    }
+    long now = timestamp(); 
+    showStage(g_stage_tickets, now); 
+    showStage(g_stage_sale_points, now); 
+    showStage(g_stage_stock, now); 
+
+    LedgerFilter tickets; 
+    tickets.type = PAY_TO; 
+    LedgerFilter food; 
+    food.type = PAY_SP; 
+    std::cout << BOLDWHITE << "[REVENUE] total_cents=" << g_ledger.revenue() << " tickets_cents=" << g_ledger.revenue(tickets) 
+              << " food_cents=" << g_ledger.revenue(food) << " rows=" << g_ledger.getRows() << " dropped=" << g_ledger.getDropped() 
+              << RESET << std::endl; 
+    showRevenue("sale_point", g_ledger.groupBy(LEDGER_SALE_POINT, food)); 
+    showRevenue("showing", g_ledger.groupBy(LEDGER_SHOWING, tickets)); 
+    showRevenue("basket", g_ledger.groupBy(LEDGER_BASKET)); 
+    showRevenue("minute", g_ledger.groupBy(LEDGER_MINUTE)); 
 }
 
 /******************************************************
- * Function name:    priorityAssignment
- * Date created:     16/4/2020
- * Input arguments:  
- * Purpose:          Assign priority to clients when paying.
+ * Function name:    showRevenue
+ * Date created:     17/10/2026
+ * Input arguments:  column of the query and its groups
+ * Purpose:          Show the sales and the cents of each group of the ledger
  * 
  ******************************************************/
-int priorityAssignment(int type_payment){
-    int priority     = 0; 
-    int num_random   = drand48(); 
+void showRevenue(std::string name, const std::vector<LedgerGroup> &groups){
+    std::cout << BOLDWHITE << "[REVENUE] by_" << name; 
+    for(unsigned i = 0; i < groups.size(); i++){
+        std::cout << " " << groups[i].key << "=" << groups[i].revenue << "/" << groups[i].rows; 
+    }
+    std::cout << RESET << std::endl; 
+}
 
-    switch (type_payment){
-        case PAY_TO:
-            if(num_random < 0.8){ 
-                priority = 1;
-            }else{
-                priority = 2;
-            }
-            break;
-    
-        case PAY_SP:
-            if(num_random > 0.8){
-                priority = 1;
-            }else{
-                priority = 2; 
+/******************************************************
+ * Function name:    showStage
+ * Date created:     17/10/2026
+ * Input arguments:  stage and time of the end of the run
+ * Purpose:          Show the workers of the stage, the fraction of the time they were busy and the wait in 
+ *                   its queues and the service time of its messages
+ * 
+ ******************************************************/
+template <typename S> 
+void showStage(S *stage, long now){
+    std::cout << BOLDWHITE << "[STAGE] " << stage->getName() << " workers=" << stage->getNumWorkers() 
+              << " processed=" << stage->getProcessed() << " steals=" << stage->getSteals() 
+              << " utilization=" << stage->getUtilization(now) 
+              << " queue_p50_us=" << stage->getWaits().getPercentile(50) << " queue_p99_us=" << stage->getWaits().getPercentile(99) 
+              << " service_p50_us=" << stage->getServices().getPercentile(50) << " service_p99_us=" << stage->getServices().getPercentile(99) 
+              << RESET << std::endl; 
+}
+
+/******************************************************
+ * Function name:    registerMetrics
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Register the metrics before the threads start. The depths of the queues, the payments in flight 
+ *                   and the seats are gauges read when a snapshot is taken
+ * 
+ ******************************************************/
+void registerMetrics(){
+    for(unsigned i = 0; i < sizeof(g_phases) / sizeof(g_phases[0]); i++){
+        g_phase_metrics[i] = g_metrics.addHistogram("cinema_" + g_phases[i]->getName() + "_us", "Latency of the phase " + g_phases[i]->getName() + " in microseconds"); 
+    }
+    g_m_service_ticket_office   = g_metrics.addHistogram("cinema_ticket_office_service_us", "Time the ticket office spends with a client without the payment"); 
+    g_m_wait_ticket_office      = g_metrics.addHistogram("cinema_ticket_office_idle_us", "Time the ticket office waits for clients"); 
+    g_m_wait_sale_point         = g_metrics.addHistogram("cinema_sale_point_idle_us", "Time a sale point waits for clients"); 
+    g_m_wait_sale_point_payment = g_metrics.addHistogram("cinema_sale_point_payment_wait_us", "Time a sale point waits for the payment"); 
+    g_m_wait_replenisher        = g_metrics.addHistogram("cinema_replenisher_idle_us", "Time the replenisher waits for requests"); 
+    g_m_wait_manager            = g_metrics.addHistogram("cinema_manager_wait_us", "Time the manager waits for clients"); 
+    g_m_journal_commit          = g_metrics.addHistogram("cinema_journal_commit_us", "Time a commit waits for the journal"); 
+    g_m_stall                   = g_metrics.addHistogram("cinema_sale_point_stall_us", "Time a client waits at a sale point without stock for a replenishment"); 
+
+    g_m_seats_sold          = g_metrics.addCounter("cinema_seats_sold_total", "Seats sold"); 
+    g_m_seats_released      = g_metrics.addCounter("cinema_seats_released_total", "Held seats released by a rejected or abandoned payment"); 
+    g_m_tickets_refused     = g_metrics.addCounter("cinema_tickets_refused_total", "Requests of tickets without enough seats"); 
+    g_m_drinks_sold         = g_metrics.addCounter("cinema_drinks_sold_total", "Drinks given to the clients"); 
+    g_m_popcorn_sold        = g_metrics.addCounter("cinema_popcorn_sold_total", "Popcorn given to the clients"); 
+    g_m_stock_returned      = g_metrics.addCounter("cinema_stock_returned_total", "Drinks and popcorn back in the stock after a rejected payment"); 
+    g_m_payments_refunded   = g_metrics.addCounter("cinema_payments_refunded_total", "Ticket payments approved after their hold expired, given back"); 
+    g_m_replenishments      = g_metrics.addCounter("cinema_replenishments_total", "Sale points replenished"); 
+    g_m_replenish_merged    = g_metrics.addCounter("cinema_replenish_merged_total", "Requests of replenishment merged with one already in the queue"); 
+    g_m_stock_restocked     = g_metrics.addCounter("cinema_stock_restocked_total", "Drinks and popcorn put by the stockers"); 
+    g_m_stalls              = g_metrics.addCounter("cinema_sale_point_stalls_total", "Clients that waited at a sale point for a replenishment"); 
+    g_m_clients_finished    = g_metrics.addCounter("cinema_clients_finished_total", "Clients that have ended"); 
+
+    g_metrics.addGauge("cinema_ticket_queue_depth", "Requests waiting in the ticket offices", [](){ return g_stage_tickets->depth(); }); 
+    g_metrics.addGauge("cinema_sale_point_queue_depth", "Requests waiting in the sale points", [](){ return g_stage_sale_points->depth(); }); 
+    g_metrics.addGauge("cinema_sale_point_steals_total", "Clients taken from the queue of another sale point", [](){ return g_stage_sale_points->getSteals(); }); 
+    g_metrics.addGauge("cinema_tickets_admitted", "Clients queued for tickets that haven't been answered", [](){ return static_cast<long>(g_admitted.load()); }); 
+    g_metrics.addGauge("cinema_waitlist_depth", "Clients waiting for released seats", [](){
+        std::lock_guard<std::mutex> lg(g_mutex_waitlists); 
+        long depth = 0; 
+        for(unsigned i = 0; i < g_waitlists.size(); i++){
+            depth += g_waitlists[i].size(); 
+        }
+        return depth; 
+    }); 
+    g_metrics.addGauge("cinema_stock_queue_depth", "Sale points waiting for the replenisher", [](){ return g_stage_stock->depth(); }); 
+    g_metrics.addGauge("cinema_payments_in_flight", "Payments sent to the processor", [](){ return static_cast<long>(g_gateway->getInFlight()); }); 
+    g_metrics.addGauge("cinema_holds_armed", "Holds waiting for their payment in the wheel", [](){ return g_holds.getArmed(); }); 
+    g_metrics.addGauge("cinema_revenue_cents", "Cents of the paid sales in the ledger", [](){ return g_ledger.revenue(); }); 
+    g_metrics.addGauge("cinema_seats_free", "Free seats of every showing", [](){
+        long free = 0; 
+        for(int showing = 1; showing <= g_inventory.getNumShowings(); showing++){
+            free += g_inventory.getFree(showing); 
+        }
+        return free; 
+    }); 
+    g_metrics.addGauge("cinema_seats_held", "Seats held waiting for the payment", [](){
+        long held = 0; 
+        for(int showing = 1; showing <= g_inventory.getNumShowings(); showing++){
+            held += g_inventory.getHeld(showing); 
+        }
+        return held; 
+    }); 
+}
+
+/******************************************************
+ * Function name:    recordPhase
+ * Date created:     17/10/2026
+ * Input arguments:  phase and latency in microseconds
+ * Purpose:          Record the latency in the results of the run and in the histogram of the phase
+ * 
+ ******************************************************/
+void recordPhase(LatencyStats &phase, long us){
+    phase.record(us); 
+    for(unsigned i = 0; i < sizeof(g_phases) / sizeof(g_phases[0]); i++){
+        if(g_phases[i] == &phase){
+            g_metrics.observe(g_phase_metrics[i], us); 
+        }
+    }
+}
+
+/******************************************************
+ * Function name:    writeResults
+ * Date created:     17/10/2026
+ * Input arguments:  time of the run
+ * Purpose:          Write the configuration, the throughput and the latency of each phase in JSON 
+ *                   to compare runs of different builds
+ * 
+ ******************************************************/
+void writeResults(std::chrono::steady_clock::duration elapsed){
+    std::ofstream out(g_results_file); 
+    if(!out){
+        std::cout << BOLDWHITE << "[MAIN] ERROR. The results can't be written in " << g_results_file << RESET << std::endl; 
+        return; 
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / 1e6; 
+    struct rusage usage; 
+    getrusage(RUSAGE_SELF, &usage); 
+
+    out << "{\n"; 
+    out << "  \"clients\": " << g_num_clients << ",\n"; 
+    out << "  \"workers\": " << g_pool->size() << ",\n"; 
+    out << "  \"clock\": \"" << (g_virtual != nullptr ? "virtual" : "real") << "\",\n"; 
+    out << "  \"time_scale\": " << g_time_scale << ",\n"; 
+    out << "  \"arrival_rate\": " << g_arrival_rate << ",\n"; 
+    out << "  \"arrivals\": \"" << g_arrivals << "\",\n"; 
+    out << "  \"distributions\": \"" << g_distributions << "\",\n"; 
+    out << "  \"seed\": " << g_seed << ",\n"; 
+    out << "  \"showings\": " << g_num_showings << ",\n"; 
+    out << "  \"sale_points\": " << g_num_sp << ",\n"; 
+    out << "  \"stockers\": " << g_num_stockers << ",\n"; 
+    out << "  \"low_watermark\": " << g_low_watermark << ",\n"; 
+    out << "  \"stalls\": " << g_metrics.getCounter(g_m_stalls) << ",\n"; 
+    out << "  \"service_ms\": {\"ticket_office\": " << g_time_ticket_office << ", \"sale_point\": " << g_time_sale_point 
+        << ", \"replenisher\": " << g_time_replenish << "},\n"; 
+    out << "  \"payment_window\": " << g_payment_window << ",\n"; 
+    out << "  \"payment_latency_ms\": " << g_payment_latency << ",\n"; 
+    out << "  \"journal\": {\"durability\": " << g_journal_durability << ", \"window_us\": " << g_journal_window 
+        << ", \"commits\": " << g_journal.getCommits() << ", \"syncs\": " << g_journal.getSyncs() << "},\n"; 
+    out << "  \"admission\": {\"enabled\": " << g_admission << ", \"backpressure\": " << g_backpressure << ", \"waitlist\": " << g_waitlist_size 
+        << ", \"sold_out\": " << g_sold_out << ", \"waitlisted\": " << g_waitlisted << ", \"promoted\": " << g_promoted << "},\n"; 
+    out << "  \"seconds\": " << seconds << ",\n"; 
+    out << "  \"simulated_seconds\": " << g_clock->now() / 1e6 << ",\n"; 
+    out << "  \"clients_per_second\": " << (seconds > 0 ? g_num_clients / seconds : 0) << ",\n"; 
+    out << "  \"tickets_per_second\": " << (seconds > 0 ? g_inventory.getSold() / seconds : 0) << ",\n"; 
+    out << "  \"tickets_sold\": " << g_inventory.getSold() << ",\n"; 
+    out << "  \"revenue\": {\"rows\": " << g_ledger.getRows() << ", \"total_cents\": " << g_ledger.revenue() 
+        << ", \"by_sale_point\": {"; 
+    std::vector<LedgerGroup> points = g_ledger.groupBy(LEDGER_SALE_POINT); 
+    for(unsigned i = 0; i < points.size(); i++){
+        out << (i > 0 ? ", " : "") << "\"" << points[i].key << "\": " << points[i].revenue; 
+    }
+    out << "}},\n"; 
+    out << "  \"context_switches\": {\"voluntary\": " << usage.ru_nvcsw << ", \"involuntary\": " << usage.ru_nivcsw << "},\n"; 
+    out << "  \"phases\": {\n"; 
+    for(unsigned i = 0; i < sizeof(g_phases) / sizeof(g_phases[0]); i++){
+        LatencyStats *phase = g_phases[i]; 
+        out << "    \"" << phase->getName() << "\": {\"count\": " << phase->getCount() << ", \"p50_us\": " << phase->getPercentile(50) 
+            << ", \"p90_us\": " << phase->getPercentile(90) << ", \"p99_us\": " << phase->getPercentile(99) 
+            << ", \"max_us\": " << phase->getMax() << "}" << (i + 1 < sizeof(g_phases) / sizeof(g_phases[0]) ? "," : "") << "\n"; 
+    }
+    out << "  },\n"; 
+    long now = timestamp(); 
+    out << "  \"stages\": {\n"; 
+    writeStage(out, g_stage_tickets, now, false); 
+    writeStage(out, g_stage_sale_points, now, false); 
+    writeStage(out, g_stage_stock, now, true); 
+    out << "  }\n"; 
+    out << "}\n"; 
+}
+
+/******************************************************
+ * Function name:    writeStage
+ * Date created:     17/10/2026
+ * Input arguments:  file of the results, stage, time of the end of the run and if it is the last stage
+ * Purpose:          Write the workers, the utilization and the latencies of the stage in JSON
+ * 
+ ******************************************************/
+template <typename S> 
+void writeStage(std::ofstream &out, S *stage, long now, bool last){
+    out << "    \"" << stage->getName() << "\": {\"workers\": " << stage->getNumWorkers() << ", \"processed\": " << stage->getProcessed() 
+        << ", \"steals\": " << stage->getSteals() << ", \"utilization\": " << stage->getUtilization(now) 
+        << ", \"queue_p50_us\": " << stage->getWaits().getPercentile(50) << ", \"queue_p99_us\": " << stage->getWaits().getPercentile(99) 
+        << ", \"service_p50_us\": " << stage->getServices().getPercentile(50) << ", \"service_p99_us\": " << stage->getServices().getPercentile(99) 
+        << "}" << (last ? "" : ",") << "\n"; 
+}
+
+/******************************************************
+ * Function name:    seatNames
+ * Date created:     17/10/2026
+ * Input arguments:  request with the seats
+ * Purpose:          Names of the seats separated by commas, empty if the lines of information aren't written
+ * 
+ ******************************************************/
+std::string seatNames(MsgRequestTickets *mrt){
+    std::string names; 
+    if(g_logger.getLevel() < LOG_INFO){ /*the line isn't written*/
+        return names; 
+    }
+    for(unsigned i = 0; i < mrt->seats.size(); i++){
+        names += (i == 0 ? "" : ", ") + g_inventory.seatName(mrt->showing, mrt->seats[i]); 
+    }
+    for(unsigned l = 0; l < mrt->legs.size(); l++){ /*a group order is showing:seats, short so it fits in the line*/
+        names += (l == 0 ? "" : " ") + std::to_string(mrt->legs[l].showing) + ":"; 
+        for(unsigned i = 0; i < mrt->legs[l].seats.size(); i++){
+            names += (i == 0 ? "" : ",") + g_inventory.seatName(mrt->legs[l].showing, mrt->legs[l].seats[i]); 
+        }
+    }
+    return names; 
+}
+
+/******************************************************
+ * Function name:    openShowings
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Add the showings to the inventory, each one in its own hall
+ * 
+ ******************************************************/
+void openShowings(){
+    for(int hall = 1; hall <= g_num_showings; hall++){
+        g_inventory.addShowing(hall, NUM_ROWS, NUM_COLS); 
+    }
+    g_waitlists.resize(g_num_showings); 
+}
+
+/******************************************************
+ * Function name:    openStages
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Create the stages of the sales. The clients are spread in turns over the ticket offices of 
+ *                   their showing and each one serves its queue in order, so the order is kept in each ticket 
+ *                   office and not between them. The sale points and the stockers take the messages of any 
+ *                   queue when they are idle. The ticket offices and the sale points answer the clients, 
+ *                   the stockers the sale points that wait for them
+ * 
+ ******************************************************/
+void openStages(){
+    g_stage_tickets = new TicketStage("ticket_office", g_num_showings * g_num_windows, queueCapacity(), ROUTE_KEY, false); 
+    g_stage_tickets->setKey([](MsgRequestTickets *mrt){ return (mrt->showing - 1) * g_num_windows + mrt->id_client % g_num_windows; }); 
+    g_stage_tickets->setHandler(ticketOffice); 
+    g_stage_tickets->setSink([](MsgRequestTickets *mrt){ mrt->complete(); }); 
+    g_stage_tickets->setOnError([](unsigned w){ g_logger.log(LOG_ERROR, EV_TICKET_OFFICE_ERROR, w / g_num_windows + 1); }); 
+    g_stage_tickets->setIdleMetric(g_m_wait_ticket_office); 
+
+    g_stage_sale_points = new SalePointStage("sale_point", g_num_sp, queueCapacity(), ROUTE_BALANCE, true); 
+    g_stage_sale_points->setHandler(salePoint); 
+    g_stage_sale_points->setSink([](MsgRequestSalePoint *mrsp){ mrsp->complete(); }); 
+    g_stage_sale_points->setOnError([](unsigned w){ g_logger.log(LOG_ERROR, EV_SALE_POINT_ERROR, w + 1); }); 
+    g_stage_sale_points->setIdleMetric(g_m_wait_sale_point); 
+
+    g_stage_stock = new StockStage("replenisher", g_num_stockers, QUEUE_CAPACITY, ROUTE_BALANCE, true); 
+    g_stage_stock->setHandler(replenish); 
+    g_stage_stock->setSink([](InfoSalePoint *sp){ sendSignal(sp->replenished); }); 
+    g_stage_stock->setOnError([](unsigned){ g_logger.log(LOG_ERROR, EV_REPLENISHER_ERROR); }); 
+    g_stage_stock->setIdleMetric(g_m_wait_replenisher); 
+}
+
+/******************************************************
+ * Function name:    openJournal
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Open the journal and give back to the showings and the sale points the state of the last run, 
+ *                   from the last snapshot and the journal after it. The sale points that are new write their stock
+ * 
+ ******************************************************/
+void openJournal(){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); 
+    JournalState state; 
+    if(!g_journal.open(g_journal_file, g_journal_durability, g_journal_window, g_journal_snapshot, state)){
+        std::cout << BOLDWHITE << "[MAIN] ERROR. The journal " << g_journal_file << " can't be opened" << RESET << std::endl; 
+        std::exit(EXIT_FAILURE); 
+    }
+    for(int showing = 1; showing <= std::min(g_num_showings, static_cast<int>(state.seats.size())); showing++){
+        for(unsigned seat = 0; seat < state.seats[showing - 1].size(); seat++){
+            if(state.seats[showing - 1][seat]){
+                g_inventory.restore(showing, seat); 
             }
-            break;
+        }
+    }
+    for(unsigned i = 0; i < g_sale_points.size(); i++){
+        InfoSalePoint *sp = g_sale_points[i]; 
+        if(i < state.drinks.size()){
+            sp->num_drinks  = std::max(0L, state.drinks[i]); 
+            sp->num_popcorn = std::max(0L, state.popcorn[i]); 
+        }else{
+            JournalRecord stock = {0, J_STOCK, 0, {sp->id, sp->num_drinks.load(), sp->num_popcorn.load()}, 0}; 
+            journal(&stock, 1); 
+        }
     }
-    return priority; 
+    std::cout << BOLDWHITE << "[JOURNAL] Recovered " << state.lsn << " records, " << state.getSold() << " seats sold and " 
+              << state.drinks.size() << " sale points in " 
+              << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0 
+              << " ms" << RESET << std::endl; 
+}
+
+/******************************************************
+ * Function name:    journal
+ * Date created:     17/10/2026
+ * Input arguments:  records of the transaction and number of records
+ * Purpose:          Commit the transaction in the journal, if there is one, and measure the time it waits. 
+ *                   It is real time because the disk doesn't follow the virtual clock
+ * 
+ ******************************************************/
+void journal(JournalRecord *records, int n){
+    if(!g_journal.isOpen()){
+        return; 
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); 
+    g_journal.commit(records, n); 
+    g_metrics.observe(g_m_journal_commit, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()); 
+}
+
+/******************************************************
+ * Function name:    journal
+ * Date created:     17/10/2026
+ * Input arguments:  records of the transaction, number of records and function to run when they are durable
+ * Purpose:          Commit the transaction without waiting for it. The function runs when the records are 
+ *                   durable, in group mode in the flusher of the journal, and at once if there is no journal. 
+ *                   In virtual time the commit takes part in the simulation until the function ends
+ * 
+ ******************************************************/
+void journal(JournalRecord *records, int n, std::function<void()> then){
+    if(!g_journal.isOpen()){
+        then(); 
+        return; 
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); 
+    g_clock->enter(); 
+    g_journal.commit(records, n, [start, then](){
+        g_metrics.observe(g_m_journal_commit, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()); 
+        then(); 
+        g_clock->leave(); 
+    }); 
 }
 
 /******************************************************
  * Function name:    createClients
  * Date created:     11/4/2020
  * Input arguments:  
- * Purpose:          Create the clients 
+ * Purpose:          Create the clients. Each client is a session that waits in the queue 
+ *                   of the ticket office until the manager gives it the turn. 
+ *                   With the admission control the arrivals wait while the queue of tickets is too long
+ * 
+ ******************************************************/
+SERVICE createClients(){
+    long start = g_clock->now(); 
+    for(int i = 1; i <= g_num_clients; i++){
+        Arrival arrival = g_workload->next(g_num_showings); 
+        long wait = start + arrival.at_us - g_clock->now(); 
+        if(wait > 0){
+            AWAIT(sleepFor(wait)); 
+        }
+        if(g_admission && g_backpressure > 0){
+            AWAIT(waitBackpressure()); 
+        }
+        ClientSession *cs = g_sessions.create(i, arrival.showing, arrival.seats, arrival.drinks, arrival.popcorn); 
+        cs->arrived_at = timestamp(); 
+        if(arrival.showings > 1){ /*a group books the same seats in the next showings too*/
+            for(int k = 0; k < arrival.showings; k++){
+                cs->mrt.legs.push_back({1 + (arrival.showing - 1 + k) % g_num_showings, arrival.seats, {}}); 
+            }
+            g_groups++; 
+        }
+        g_logger.log(LOG_INFO, EV_CLIENT_CREATED, i); 
+        admitClient(cs); 
+    }
+    endService(); 
+}
+
+/******************************************************
+ * Function name:    waitBackpressure
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Wait while the clients queued for tickets are g_backpressure or more. The arrivals are marked 
+ *                   as blocked before the depth is read again, so the answer that lowers it always wakes them
  * 
  ******************************************************/
-void createClients(){
-    for(int i = 1; i <= NUM_CLIENTS; i++){
-        g_queue_tickets.push(std::thread(client, i));
-        std::this_thread::sleep_for(std::chrono::milliseconds(500)); 
+ASYNC(void) waitBackpressure(){
+    while(g_admitted.load() >= g_backpressure){
+        g_arrivals_blocked = true; 
+        if(g_admitted.load() >= g_backpressure){
+            g_backpressure_waits++; 
+            AWAIT(waitSignal(g_sem_admission)); 
+        }
     }
 }
 
+/******************************************************
+ * Function name:    admission
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client and showing that decides the answer
+ * Purpose:          Decide without any lock of the inventory what to do with the request. ADMIT_REJECT if a showing 
+ *                   can't give the seats even when every hold is released, ADMIT_WAIT if the seats are only held 
+ *                   by other clients and ADMIT_QUEUE if they are free now
+ * 
+ ******************************************************/
+int admission(MsgRequestTickets *mrt, int &showing){
+    int admit = ADMIT_QUEUE; 
+    for(unsigned l = 0; l < std::max<size_t>(1, mrt->legs.size()); l++){
+        int sh = mrt->legs.empty() ? mrt->showing : mrt->legs[l].showing; 
+        int n  = mrt->legs.empty() ? mrt->num_seats : mrt->legs[l].num_seats; 
+        if(g_inventory.getRemaining(sh) < n){
+            showing = sh; 
+            return ADMIT_REJECT; 
+        }
+        if(admit == ADMIT_QUEUE && g_inventory.getAvailable(sh) < n){
+            showing = sh; 
+            admit   = ADMIT_WAIT; 
+        }
+    }
+    return admit; 
+}
+
+/******************************************************
+ * Function name:    admitClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          The client goes to the queue of tickets, waits in the waitlist of the showing whose seats are 
+ *                   held or goes home at once. With the waitlist full it goes to the queue as before. The decision 
+ *                   and the waitlist are under the same lock that the promotions take, so a hold released 
+ *                   meanwhile always finds the client
+ * 
+ ******************************************************/
+void admitClient(ClientSession *cs){
+    if(!g_admission){
+        queueClient(cs); 
+        return; 
+    }
+    int showing; 
+    g_mutex_waitlists.lock(); 
+        int admit = admission(&(cs->mrt), showing); 
+        if(admit == ADMIT_WAIT && static_cast<int>(g_waitlists[showing - 1].size()) < g_waitlist_size){
+            g_waitlists[showing - 1].push_back(cs); 
+        }else if(admit == ADMIT_WAIT){ /*the waitlist is full, the ticket office may find the seats released*/
+            admit = ADMIT_QUEUE; 
+        }
+    g_mutex_waitlists.unlock(); 
+
+    switch(admit){
+        case ADMIT_QUEUE:
+            queueClient(cs); 
+            break; 
+        case ADMIT_WAIT:
+            g_waitlisted++; 
+            g_logger.log(LOG_INFO, EV_CLIENT_WAITLISTED, cs->id, showing); 
+            break; 
+        case ADMIT_REJECT:
+            refuseClient(cs); 
+            break; 
+    }
+}
+
+/******************************************************
+ * Function name:    queueClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          Put the client in the queue of tickets and wake the manager
+ * 
+ ******************************************************/
+void queueClient(ClientSession *cs){
+    g_admitted++; 
+    g_sem_mutex_clients.lock(); 
+        g_queue_tickets.push(cs);
+    g_sem_mutex_clients.unlock(); 
+    sendSignal(g_sem_clients_arrived); 
+}
+
+/******************************************************
+ * Function name:    refuseClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          The client goes home without the ticket office because its seats can't be sold to it
+ * 
+ ******************************************************/
+void refuseClient(ClientSession *cs){
+    g_logger.log(LOG_INFO, EV_CLIENT_SOLD_OUT, cs->id, cs->mrt.showing); 
+    g_sold_out++; 
+    g_metrics.increment(g_m_tickets_refused); 
+    recordPhase(g_lat_refused, timestamp() - cs->arrived_at); 
+    g_sem_mutex_clients.lock(); 
+        g_queue_clients_out.push(cs->id);
+    g_sem_mutex_clients.unlock(); 
+    finishClient(cs); 
+}
+
+/******************************************************
+ * Function name:    promoteWaitlist
+ * Date created:     17/10/2026
+ * Input arguments:  request whose held seats have been sold or released
+ * Purpose:          Check again the waitlists of the showings of the request. The clients whose seats are free now 
+ *                   go to the queue of tickets, while the released seats last, and the ones that can't be served 
+ *                   anymore go home. A group order that still waits for another showing moves to its waitlist
+ * 
+ ******************************************************/
+void promoteWaitlist(MsgRequestTickets *mrt){
+    if(!g_admission){
+        return; 
+    }
+    std::vector<ClientSession*> promoted, refused; 
+    g_mutex_waitlists.lock(); 
+    for(unsigned l = 0; l < std::max<size_t>(1, mrt->legs.size()); l++){
+        int showing = mrt->legs.empty() ? mrt->showing : mrt->legs[l].showing; 
+        std::deque<ClientSession*> &waitlist = g_waitlists[showing - 1]; 
+        int free = g_inventory.getAvailable(showing); /*seats given to the clients promoted in this pass*/
+        for(unsigned i = 0; i < waitlist.size(); ){
+            ClientSession *cs = waitlist[i]; 
+            int sh; 
+            int admit = admission(&(cs->mrt), sh); 
+            if(admit == ADMIT_QUEUE && cs->mrt.legs.empty()){
+                if(cs->mrt.num_seats > free){
+                    admit = ADMIT_WAIT; 
+                    sh    = showing; 
+                }else{
+                    free -= cs->mrt.num_seats; 
+                }
+            }
+            if(admit == ADMIT_WAIT && sh == showing){
+                i++; 
+                continue; 
+            }
+            waitlist.erase(waitlist.begin() + i); 
+            if(admit == ADMIT_REJECT){
+                refused.push_back(cs); 
+            }else if(admit == ADMIT_WAIT && static_cast<int>(g_waitlists[sh - 1].size()) < g_waitlist_size){
+                g_waitlists[sh - 1].push_back(cs); 
+            }else{
+                promoted.push_back(cs); 
+            }
+        }
+    }
+    g_mutex_waitlists.unlock(); 
+
+    for(unsigned i = 0; i < promoted.size(); i++){
+        g_promoted++; 
+        g_logger.log(LOG_INFO, EV_CLIENT_PROMOTED, promoted[i]->id); 
+        queueClient(promoted[i]); 
+    }
+    for(unsigned i = 0; i < refused.size(); i++){
+        refuseClient(refused[i]); 
+    }
+}
+
+/******************************************************
+ * Function name:    ticketsAnswered
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          The ticket office has answered a client, the arrivals go on if they were waiting for the queue
+ * 
+ ******************************************************/
+void ticketsAnswered(){
+    if(--g_admitted < g_backpressure && g_arrivals_blocked.exchange(false)){
+        sendSignal(g_sem_admission); 
+    }
+}
+
+#ifdef CINEMA_COROUTINES
+/******************************************************
+ * Function name:    client
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          The client as a coroutine. It does the same steps as the session of the threaded mode 
+ *                   but it waits for the ticket office and the sale point suspended, without a thread
+ * 
+ ******************************************************/
+Task client(ClientSession *cs){
+    g_logger.log(LOG_INFO, EV_CLIENT_TURN, cs->id); 
+    g_logger.log(LOG_INFO, EV_CLIENT_WANTS_TICKETS, cs->id, cs->mrt.num_seats, cs->mrt.showing); 
+    cs->mrt.requested_at = timestamp(); 
+    cs->mrt.post(); 
+    co_await Handoff{cs->mrt.on_attended, [cs](){ g_stage_tickets->submit(&(cs->mrt)); }}; 
+    ticketsAnswered(); 
+
+    if(!cs->mrt.suff_seats){
+        g_logger.log(LOG_INFO, EV_CLIENT_NO_TICKETS, cs->id); 
+        recordPhase(g_lat_refused, timestamp() - cs->arrived_at); 
+        g_sem_mutex_clients.lock(); 
+            g_queue_clients_out.push(cs->id);
+        g_sem_mutex_clients.unlock(); 
+        finishClient(cs); 
+        co_return; 
+    }
+    g_logger.logText(LOG_INFO, EV_CLIENT_HAS_TICKETS, seatNames(&(cs->mrt)), cs->id); 
+
+    g_logger.log(LOG_INFO, EV_CLIENT_WANTS_FOOD, cs->id, cs->mrsp.num_drinks, cs->mrsp.num_popcorn); 
+    cs->mrsp.requested_at = timestamp(); 
+    cs->mrsp.post(); 
+    co_await Handoff{cs->mrsp.on_attended, [cs](){ g_stage_sale_points->submit(&(cs->mrsp)); }}; 
+
+    g_logger.log(LOG_INFO, EV_CLIENT_HAS_FOOD, cs->id); 
+    g_logger.log(LOG_INFO, EV_CLIENT_TO_MOVIE, cs->id); 
+    g_sem_mutex_clients.lock(); 
+        g_queue_cinema.push(cs->id); 
+    g_sem_mutex_clients.unlock(); 
+    finishClient(cs); 
+}
+
+/******************************************************
+ * Function name:    resumeClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          Start the coroutine of the client when it has the turn
+ * 
+ ******************************************************/
+void resumeClient(ClientSession *cs){ 
+    g_executor->spawn(client(cs)); 
+}
+#else
 /******************************************************
  * Function name:    client
  * Date created:     11/4/2020
- * Input arguments:  id of client 
+ * Input arguments:  session of client 
  * Purpose:          It simulate the client. The client go to the ticket office and when the client has the turn send the request of tickets.
  *                   When the ticket office attends the request, the client waits. If there are sufficient tickets the client 
- *                   come in the cinema and buy drinks and popcorn
+ *                   come in the cinema and buy drinks and popcorn.
+ *                   Each call runs the next step of the session in the pool and returns instead of blocking the worker
  * 
  ******************************************************/
-void client(int id_client){
-    std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] Created and waiting to buy tickets..." << RESET << std::endl;
-    MsgRequestTickets mrt = buyTickets(id_client); 
-    checkTicketsClient(id_client, mrt); 
+void client(ClientSession *cs){
+    switch(cs->state){
+        case CLIENT_REQUEST_TICKETS:
+            buyTickets(cs); 
+            break; 
+        case CLIENT_CHECK_TICKETS:
+            checkTicketsClient(cs); 
+            break; 
+        case CLIENT_RECEIVE_FOOD:
+            g_logger.log(LOG_INFO, EV_CLIENT_HAS_FOOD, cs->id); 
+            g_logger.log(LOG_INFO, EV_CLIENT_TO_MOVIE, cs->id); 
+            g_sem_mutex_clients.lock(); 
+                g_queue_cinema.push(cs->id); 
+            g_sem_mutex_clients.unlock(); 
+            finishClient(cs); 
+            break; 
+    }
 }
 
+/******************************************************
+ * Function name:    resumeClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          Submit the next step of the client to the pool
+ * 
+ ******************************************************/
+void resumeClient(ClientSession *cs){ 
+    g_clock->enter(); /*the task takes part in the simulation until it ends*/
+    g_pool->submit([cs](){ 
+        client(cs); 
+        g_clock->leave(); 
+    }); 
+}
+#endif
+
+/******************************************************
+ * Function name:    finishClient
+ * Date created:     17/10/2026
+ * Input arguments:  session of client 
+ * Purpose:          Give the session back to the pool and count the client as finished. 
+ *                   A request still owned by a service is an error, then the session is never freed
+ * 
+ ******************************************************/
+void finishClient(ClientSession *cs){
+    if(cs->mrt.inFlight() || cs->mrsp.inFlight()){
+        g_logger.log(LOG_ERROR, EV_CLIENT_ERROR, cs->id); 
+    }else{
+        g_sessions.destroy(cs); 
+    }
+    g_metrics.increment(g_m_clients_finished); 
+    sendSignal(g_sem_clients_done); 
+}
+
+#ifndef CINEMA_COROUTINES
 /******************************************************
  * Function name:    buyTickets
  * Date created:     12/4/2020
@@ -221,23 +1589,16 @@ void client(int id_client){
  * Purpose:          The client buys tickets
  * 
  ******************************************************/
-MsgRequestTickets buyTickets(int id_client){
-    /*Wait turn of office ticket*/
-    std::unique_lock<std::mutex> ul_turn_ticket(g_sem_turn_tickets); 
-        g_cv_ticket_office.wait(ul_turn_ticket, [id_client]{return g_turn_tickets == id_client;}); 
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] It's my turn for buy tickets!" << RESET << std::endl; 
-    ul_turn_ticket.unlock(); 
+void buyTickets(ClientSession *cs){
+    g_logger.log(LOG_INFO, EV_CLIENT_TURN, cs->id); 
 
-    /*Generate the request to buy a tickets*/
-    MsgRequestTickets mrt(id_client, generateRandomNumber(MAX_REQUEST_TICKETS));
-    g_queue_request_tickets.push(&mrt); 
-    std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] I want " << std::to_string(mrt.num_seats) << " tickets" << RESET << std::endl; 
-
-    /*Unlocked the ticket office and wait to receive tickets*/
-    g_sem_toffice.unlock(); 
-    g_sem_tickets.lock(); 
-
-    return mrt;
+    /*Send the request to buy a tickets, the ticket office of the showing resumes the client when it answers*/
+    cs->state            = CLIENT_CHECK_TICKETS; 
+    cs->mrt.on_attended  = std::bind(resumeClient, cs); 
+    g_logger.log(LOG_INFO, EV_CLIENT_WANTS_TICKETS, cs->id, cs->mrt.num_seats, cs->mrt.showing); 
+    cs->mrt.requested_at = timestamp(); 
+    cs->mrt.post(); /*the ticket office owns the request until it completes it*/
+    g_stage_tickets->submit(&(cs->mrt)); /*It wakes the ticket office*/
 }
 
 /******************************************************
@@ -248,215 +1609,446 @@ MsgRequestTickets buyTickets(int id_client){
  *                   he will buy drinks and popcorn. If there are not enough tickets the client leaves the cinema.
  * 
  ******************************************************/
-void checkTicketsClient(int id_client, MsgRequestTickets mrt){
+void checkTicketsClient(ClientSession *cs){
+    ticketsAnswered(); 
+
     /*Check it the client has sufficient seats and it can buy drinks and popcorn*/
-    if(mrt.suff_seats == true){
+    if(cs->mrt.suff_seats == true){
         /*The client goes inside the cinema*/
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] I have the tickets already. I go to buy drinks and popcorn..." << RESET << std::endl; 
-        g_sem_manager_tickets.unlock(); /*It unlocks the turn to the next client sends the request*/
-        g_queue_drinkpop.push(std::move(g_queue_tickets.front()));
-        g_queue_tickets.pop(); 
-        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        g_logger.logText(LOG_INFO, EV_CLIENT_HAS_TICKETS, seatNames(&(cs->mrt)), cs->id); 
 
         /*The client buys drinks and popcorn*/
-        buyDrinksPopcorn(id_client); 
-        std::this_thread::sleep_for(std::chrono::milliseconds(600)); 
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] I have everything already. I go to see Harry Potter now! :)" << RESET << std::endl;
+        buyDrinksPopcorn(cs); 
     }else{
-        g_queue_clients_out.push(std::move(g_queue_tickets.front()));
-        g_queue_tickets.pop();
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] No tickets left so I go to my house :(" << RESET << std::endl;
-        g_sem_manager_tickets.unlock(); /*It unlocks the turn to the next client sends the request*/
+        g_logger.log(LOG_INFO, EV_CLIENT_NO_TICKETS, cs->id); 
+        recordPhase(g_lat_refused, timestamp() - cs->arrived_at); 
+        g_sem_mutex_clients.lock(); 
+            g_queue_clients_out.push(cs->id);
+        g_sem_mutex_clients.unlock(); 
+        finishClient(cs); 
     }
 }
+#endif
 
 /******************************************************
  * Function name:    ticketOffice
  * Date created:     12/4/2020
- * Input arguments:  
- * Purpose:          It simulate the ticket office. The sale point checks if there are enough tickets 
- *                   for the customer. If there is then give the tickets to the customer and ask for the request for payment. 
+ * Input arguments:  request of the client and worker of the stage, not used because the key of the stage chose it
+ * Purpose:          It simulate the ticket office of a showing. The ticket office holds the seats of the client and 
+ *                   asks for the payment, then it serves the next client while the payment is in flight. The client is 
+ *                   resumed when the payment confirms or releases the hold, otherwise the request is given back 
+ *                   to the stage that resumes it now. 
+ *                   Each showing has its own ticket offices so the showings are sold in parallel
  * 
  ******************************************************/
-void ticketOffice(){
-    std::cout << GREEN << "[TICKET OFFICE] Ticket office open" << RESET << std::endl; 
-    while(true){
-        try{
-            g_sem_toffice.lock(); 
-            MsgRequestTickets *mrt = g_queue_request_tickets.front(); 
-            g_queue_request_tickets.pop(); 
-
-            /*Check number of tickets*/
-            checkNumTickets(mrt);
-            std::this_thread::sleep_for(std::chrono::milliseconds(400));
-            std::cout << GREEN << "[TICKET OFFICE] The client " << std::to_string(mrt->id_client) << " has been attended" << RESET << std::endl;
-            g_sem_tickets.unlock(); /*It unlocks to attend other clients*/ 
-            
-        }catch(std::exception &e){
-            std::cout << GREEN << "[TICKET OFFICE] An error occurred while attending clients..." << RESET << std::endl;
-            g_sem_tickets.unlock();
-        }
+ASYNC(MsgRequestTickets*) ticketOffice(MsgRequestTickets *mrt, unsigned){
+    mrt->served_at = timestamp(); 
+    recordPhase(g_lat_ticket_queue, mrt->served_at - mrt->requested_at); 
+
+    /*Check number of tickets, the client waits for the payment if the seats are held*/
+    bool held = AWAIT(checkNumTickets(mrt)); 
+    g_metrics.observe(g_m_service_ticket_office, timestamp() - mrt->served_at); 
+    if(held){
+        RETURN(nullptr); 
     }
+    g_logger.log(LOG_INFO, EV_TICKET_OFFICE_ATTENDED, mrt->showing, mrt->id_client); 
+    recordPhase(g_lat_ticket_office, timestamp() - mrt->served_at); 
+    RETURN(mrt); 
 }
 
 /******************************************************
  * Function name:    checkNumTickets
  * Date created:     22/4/2020
  * Input arguments:  
- * Purpose:          Check tickets  
- * 
- ******************************************************/
-void checkNumTickets(MsgRequestTickets *mrt){
-    if(g_num_seats >= mrt->num_seats){
-        std::cout << GREEN << "[TICKET OFFICE] The client " << mrt->id_client << " has requested " << mrt->num_seats  << " tickets"<< RESET << std::endl; 
-
-        g_sem_mutex_payment.lock();
-        MsgRequestPayment mrp(mrt->id_client, priorityAssignment(PAY_TO));
-        g_queue_request_payment.push(&mrp);
-        std::this_thread::sleep_for(std::chrono::milliseconds(400)); /*sleep the thread each time that the client pays tickets*/
-        std::cout << GREEN << "[TICKET OFFICE] I request the client's payment"<< RESET << std::endl; 
-        /*Wait confirmation of payment system*/
-        std::unique_lock<std::mutex> ul_wait_payment(g_sem_wait_payment); 
-            /*Seat allocation and payment system simultaneous*/ 
-            g_sem_payment.signal();  
-            g_sem_seats.signal();
-            bool *p_flag_attended = &(mrp.attended);
-            g_cv_payment.wait(ul_wait_payment, [p_flag_attended] {return *p_flag_attended;});  
-            g_sem_mutex_payment.unlock();
-        ul_wait_payment.unlock();
-
-        /*Check if the payment was successful*/
-        checkPaymentTicketOffice(mrp, mrt);
+ * Purpose:          Check tickets. If there are enough the seats are held and the payment is requested, 
+ *                   it returns true when the client waits for the payment. With the admission control 
+ *                   a showing that is sold out is refused without the service time
+ * 
+ ******************************************************/
+ASYNC(bool) checkNumTickets(MsgRequestTickets *mrt){
+    if(holdTickets(mrt)){
+        g_logger.logText(LOG_INFO, EV_TICKET_OFFICE_HELD, seatNames(mrt), mrt->showing, mrt->id_client, mrt->num_seats); 
+
+        TicketPayment *tp = g_ticket_payments.create(mrt); 
+        AWAIT(simulateDelay(g_time_ticket_office)); /*sleep the thread each time that the client pays tickets*/
+        g_logger.log(LOG_DEBUG, EV_TICKET_OFFICE_PAYMENT, mrt->showing); 
+
+        /*The payment is in flight out of the ticket office, it confirms the hold when it ends or the wheel releases it before*/
+        tp->hold = armHold(mrt); 
+        paymentSystem(&(tp->mrp), [tp](){ checkPaymentTicketOffice(tp); }); 
+        RETURN(true); 
+    }
+    int showing; 
+    if(!mrt->legs.empty()){ /*the legs taken before the one that failed were free for a moment*/
+        promoteWaitlist(mrt); 
+    }
+    if(!g_admission || admission(mrt, showing) != ADMIT_REJECT){
+        AWAIT(simulateDelay(g_time_ticket_office));
+    }
+    g_logger.log(LOG_INFO, EV_TICKET_OFFICE_REFUSED, mrt->showing, mrt->id_client); 
+    mrt->suff_seats = false; 
+    g_metrics.increment(g_m_tickets_refused); 
+    RETURN(false); 
+}
+
+/******************************************************
+ * Function name:    holdTickets
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client
+ * Purpose:          Hold the seats of the showing or, for a group order, of every showing or none
+ * 
+ ******************************************************/
+bool holdTickets(MsgRequestTickets *mrt){
+    if(mrt->legs.empty()){
+        return g_inventory.hold(mrt->showing, mrt->num_seats, mrt->seats); 
+    }
+    return g_inventory.holdGroup(mrt->legs); 
+}
+
+/******************************************************
+ * Function name:    confirmTickets
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client
+ * Purpose:          The held seats are sold
+ * 
+ ******************************************************/
+void confirmTickets(MsgRequestTickets *mrt){
+    if(mrt->legs.empty()){
+        g_inventory.confirm(mrt->showing, mrt->seats); 
     }else{
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        std::cout << GREEN << "[TICKET OFFICE] The client " << std::to_string(mrt->id_client) << " has requested more tickets than there are left" << RESET << std::endl;
-        mrt->suff_seats = false; 
+        g_inventory.confirmGroup(mrt->legs); 
+        g_groups_sold++; 
+    }
+}
+
+/******************************************************
+ * Function name:    releaseTickets
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client
+ * Purpose:          The held seats are free again
+ * 
+ ******************************************************/
+void releaseTickets(MsgRequestTickets *mrt){
+    if(mrt->legs.empty()){
+        g_inventory.releaseHold(mrt->showing, mrt->seats); 
+    }else{
+        g_inventory.releaseGroupHold(mrt->legs); 
+    }
+}
+
+/******************************************************
+ * Function name:    countSeats
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client
+ * Purpose:          Seats that the request has
+ * 
+ ******************************************************/
+int countSeats(MsgRequestTickets *mrt){
+    int n = mrt->seats.size(); 
+    for(unsigned l = 0; l < mrt->legs.size(); l++){
+        n += mrt->legs[l].seats.size(); 
+    }
+    return n; 
+}
+
+/******************************************************
+ * Function name:    ledgerTickets
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client with the seats sold
+ * Purpose:          Append the sale to the ledger, a row for each showing of the request
+ * 
+ ******************************************************/
+void ledgerTickets(MsgRequestTickets *mrt){
+    unsigned second = timestamp() / 1000000; 
+    if(!mrt->seats.empty()){
+        g_ledger.append(second, PAY_TO, 0, mrt->showing, mrt->seats.size(), mrt->seats.size() * TICKET_PRICE); 
+    }
+    for(unsigned l = 0; l < mrt->legs.size(); l++){
+        int seats = mrt->legs[l].seats.size(); 
+        g_ledger.append(second, PAY_TO, 0, mrt->legs[l].showing, seats, seats * TICKET_PRICE); 
     }
 }
 
 /******************************************************
  * Function name:    checkPaymentTicketOffice
  * Date created:     22/4/2020
- * Input arguments:  
- * Purpose:          Check if the payment was successful 
+ * Input arguments:  payment with the request of the client and the timer of the hold
+ * Purpose:          Check if the payment was successful. It confirms the held seats or releases them 
+ *                   if the payment was rejected. If the timer of the hold has already fired the seats are 
+ *                   back in the inventory and the client has none, an approved payment is then refunded. 
+ *                   The result goes to the journal and endTicketPayment ends the sale when it is durable
  * 
  ******************************************************/
-void checkPaymentTicketOffice(MsgRequestPayment mrp, MsgRequestTickets *mrt){
-    if(mrp.attended == true){ 
-        /*Updated the number of tickets left*/
-        g_sem_seats.wait(); 
-        g_num_seats     -= mrt->num_seats;  
-        mrt->suff_seats  = true; 
-        std::cout << GREEN << "[TICKET OFFICE] " << g_num_seats << " tickets left" << RESET << std::endl;
+void checkPaymentTicketOffice(TicketPayment *tp){
+    MsgRequestPayment *mrp = &(tp->mrp); 
+    MsgRequestTickets *mrt = tp->mrt; 
+    bool abandoned = tp->hold != 0 && !g_holds.cancel(tp->hold); 
+    if(mrp->approved == true && !abandoned){ 
+        /*The held seats are sold, they are in the journal before the client knows it. The batch is on the 
+          stack unless the request has more seats than it holds*/
+        JournalRecord              batch[MAX_REQUEST_TICKETS * MAX_GROUP_SHOWINGS + 1]; 
+        std::vector<JournalRecord> larger; 
+        JournalRecord             *records = batch; 
+        if(countSeats(mrt) + 1 > static_cast<int>(sizeof(batch) / sizeof(batch[0]))){
+            larger.resize(countSeats(mrt) + 1); 
+            records = larger.data(); 
+        }
+        int n = 0; 
+        for(unsigned i = 0; i < mrt->seats.size(); i++){
+            records[n++] = {0, J_SEAT_SOLD, 0, {mrt->showing, mrt->seats[i], 0}, 0}; 
+        }
+        for(unsigned l = 0; l < mrt->legs.size(); l++){
+            for(unsigned i = 0; i < mrt->legs[l].seats.size(); i++){
+                records[n++] = {0, J_SEAT_SOLD, 0, {mrt->legs[l].showing, mrt->legs[l].seats[i], 0}, 0}; 
+            }
+        }
+        records[n++] = {0, J_PAYMENT, 0, {mrt->id_client, PAY_TO, J_PAY_APPROVED}, 0}; 
+        journal(records, n, [tp](){ endTicketPayment(tp, true, false); }); 
     }else{
+        /*Approved after the wheel released the seats: there is no sale, the money is given back*/
+        JournalRecord payment = {0, J_PAYMENT, 0, {mrt->id_client, PAY_TO, mrp->approved ? J_PAY_REFUNDED : J_PAY_REJECTED}, 0}; 
+        journal(&payment, 1, [tp, abandoned](){ endTicketPayment(tp, false, abandoned); }); 
+    }
+}
+
+/******************************************************
+ * Function name:    endTicketPayment
+ * Date created:     17/10/2026
+ * Input arguments:  payment, if the seats are sold and if the wheel released them before
+ * Purpose:          The payment is in the journal: the seats are sold or free again and the client is resumed. 
+ *                   It runs in the thread of the gateway or, in group mode, in the flusher of the journal, 
+ *                   so the gateway never waits for a sync
+ * 
+ ******************************************************/
+void endTicketPayment(TicketPayment *tp, bool sold, bool abandoned){
+    MsgRequestPayment *mrp = &(tp->mrp); 
+    MsgRequestTickets *mrt = tp->mrt; 
+    if(sold){
+        confirmTickets(mrt); 
+        promoteWaitlist(mrt); /*the clients waiting for these seats may not fit anymore*/
+        g_metrics.increment(g_m_seats_sold, countSeats(mrt)); 
+        ledgerTickets(mrt); 
+        mrt->suff_seats  = true;  
+        g_logger.log(LOG_DEBUG, EV_TICKET_OFFICE_LEFT, mrt->showing, g_inventory.getFree(mrt->showing)); 
+    }else{
+        if(mrp->approved){
+            g_metrics.increment(g_m_payments_refunded); 
+        }
+        if(!abandoned){ /*an expired hold was released by the wheel*/
+            g_logger.log(LOG_INFO, EV_TICKET_OFFICE_REJECTED, mrt->showing, mrt->id_client); 
+            releaseTickets(mrt); 
+            promoteWaitlist(mrt); 
+            g_metrics.increment(g_m_seats_released, countSeats(mrt)); 
+        }
+        mrt->seats.clear(); 
+        for(unsigned l = 0; l < mrt->legs.size(); l++){
+            mrt->legs[l].seats.clear(); 
+        }
         mrt->suff_seats  = false; 
     }
+    g_ticket_payments.destroy(tp); 
+    g_logger.log(LOG_INFO, EV_TICKET_OFFICE_ATTENDED, mrt->showing, mrt->id_client); 
+    recordPhase(g_lat_ticket_office, timestamp() - mrt->served_at); 
+    mrt->complete(); /*It resumes the client*/ 
+}
+
+/******************************************************
+ * Function name:    holdsExpire
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          True if the holds have a timeout. In real time without delays the time doesn't advance
+ * 
+ ******************************************************/
+bool holdsExpire(){
+    return g_hold_timeout > 0 && (g_virtual != nullptr || g_time_scale > 0); 
 }
 
+/******************************************************
+ * Function name:    armHold
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client with the seats held
+ * Purpose:          Arm the timer of the hold in the wheel and wake the service of the holds if it was empty. 
+ *                   It returns the timer, 0 if the holds don't expire
+ * 
+ ******************************************************/
+unsigned long armHold(MsgRequestTickets *mrt){
+    if(!holdsExpire()){
+        return 0; 
+    }
+    bool first; 
+    unsigned long hold = g_holds.arm(g_clock->now() + g_hold_timeout * 1000L, mrt, &first); 
+    if(first){
+        sendSignal(g_sem_holds); 
+    }
+    return hold; 
+}
+
+/******************************************************
+ * Function name:    expireHold
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client whose hold has expired
+ * Purpose:          The payment hasn't arrived in time, the held seats go back to the inventory. The client keeps 
+ *                   waiting for the payment, which finds the timer fired and doesn't give it the seats
+ * 
+ ******************************************************/
+void expireHold(void *data){
+    MsgRequestTickets *mrt = static_cast<MsgRequestTickets*>(data); 
+    releaseTickets(mrt); 
+    promoteWaitlist(mrt); 
+    g_metrics.increment(g_m_seats_released, countSeats(mrt)); 
+    g_holds_abandoned++; 
+    g_logger.log(LOG_INFO, EV_TICKET_OFFICE_EXPIRED, mrt->showing, mrt->id_client); 
+}
+
+/******************************************************
+ * Function name:    expireHolds
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Service that turns the wheel of the holds each tick while it has timers, 
+ *                   with the wheel empty it waits until a ticket office arms one
+ * 
+ ******************************************************/
+SERVICE expireHolds(){
+    while(!g_holds_closed){
+        if(g_holds.getArmed() == 0){
+            AWAIT(waitSignal(g_sem_holds)); 
+            continue; 
+        }
+        AWAIT(sleepFor(HOLD_TICK * 1000L)); 
+        g_holds.expire(g_clock->now(), expireHold); 
+    }
+    endService(); 
+}
+
+#ifndef CINEMA_COROUTINES
 /******************************************************
  * Function name:    buyDrinksPopcorn
  * Date created:     23/4/2020
  * Input arguments:  
- * Purpose:          The client sends a request to the sale points to buy drinks and popcorn 
+ * Purpose:          The client sends a request to the sale points to buy drinks and popcorn. 
+ *                   The sale point that attends it resumes the client
  * 
  ******************************************************/
-void buyDrinksPopcorn(int id_client){
-    /*Generate the request to buy drinks and popcorn*/
-    MsgRequestSalePoint mrsp(id_client, generateRandomNumber(MAX_REQUEST_DRINK_POP), generateRandomNumber(MAX_REQUEST_DRINK_POP));
-    g_queue_request_sp.push(&mrsp); 
-    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-    
-    /*Wait turn of sale point*/
-    std::unique_lock<std::mutex> ul_turn_food(g_sem_turn_food); 
-        g_sem_sale_point.signal();
-        int *p_flag_id_sp = &(mrsp.id_sp_attend);
-        g_cv_drinks_popcorn.wait(ul_turn_food, [p_flag_id_sp]{return p_flag_id_sp != 0;}); 
-        std::cout << CYAN << "[MANAGER] It's the turn of client " << std::to_string(id_client) << " to buy drinks and popcorn" << RESET << std::endl;
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] It's my turn for buy drinks and popcorn!" << RESET << std::endl; 
-    ul_turn_food.unlock();
-
-    std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] I want " << std::to_string(mrsp.num_drinks) << " drinks and ";
-    std::cout << std::to_string(mrsp.num_popcorn) << " popcorn" << RESET << std::endl; 
-
-    std::unique_lock<std::mutex> ul_drink_popcorn(g_sem_drink_popcorn); 
-        bool *p_flag_attended = &(mrsp.attended);
-        g_cv_receive_food.wait(ul_drink_popcorn, [p_flag_attended]{return *p_flag_attended;}); 
-        std::cout << YELLOW << "[CLIENT " << std::to_string(id_client) << "] I have received drinks and popcorn" << RESET << std::endl;     
+void buyDrinksPopcorn(ClientSession *cs){
+    /*Send the request to buy drinks and popcorn*/
+    cs->state            = CLIENT_RECEIVE_FOOD; 
+    cs->mrsp.on_attended = std::bind(resumeClient, cs); 
+    g_logger.log(LOG_INFO, EV_CLIENT_WANTS_FOOD, cs->id, cs->mrsp.num_drinks, cs->mrsp.num_popcorn); 
+    cs->mrsp.requested_at = timestamp(); 
+    cs->mrsp.post(); 
+    g_stage_sale_points->submit(&(cs->mrsp)); /*It wakes a sale point*/
 }
+#endif
 
 /******************************************************
  * Function name:    salePoint
  * Date created:     23/4/2020
- * Input arguments:  
+ * Input arguments:  request of the client and worker of the stage, the sale point
  * Purpose:          It simulate the sale point. Check if there are enough stocks for the client. 
  *                   If there are, the client is given drinks and popcorn and send a request to pay. If there aren't stocks we call the replenisher
  * 
  ******************************************************/
-void salePoint(InfoSalePoint &sp){
-    std::cout << MAGENTA << "[SALE POINT " << sp.id << "] Created with " << sp.num_drinks << " drinks and " << sp.num_popcorn << " popcorn" << RESET << std::endl;
-    while(true){
-        try{ 
-            g_sem_sale_point.wait(); 
-            g_sem_mutex_access_sp.lock(); 
-                MsgRequestSalePoint *mrsp = g_queue_request_sp.front(); 
-                g_queue_request_sp.pop(); 
-                mrsp->id_sp_attend = sp.id;
-                g_cv_drinks_popcorn.notify_all(); 
-            g_sem_mutex_access_sp.unlock(); 
-            std::this_thread::sleep_for(std::chrono::milliseconds(400)); 
-
-            checkNumDrinksPopcorn(mrsp, std::ref(sp));
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            std::cout << MAGENTA << "[SALE POINT " << sp.id << "] Client " << std::to_string(mrsp->id) << " has been attended" << RESET << std::endl;
-            mrsp->attended = true; 
-            g_cv_receive_food.notify_all(); 
+ASYNC(MsgRequestSalePoint*) salePoint(MsgRequestSalePoint *mrsp, unsigned id){
+    InfoSalePoint &sp = *g_sale_points[id]; 
+    mrsp->id_sp_attend = sp.id;
+    mrsp->served_at    = timestamp(); 
+    recordPhase(g_lat_sale_point_queue, mrsp->served_at - mrsp->requested_at); 
+    g_logger.log(LOG_DEBUG, EV_MANAGER_FOOD_TURN, mrsp->id); 
+    AWAIT(simulateDelay(g_time_sale_point)); 
 
-        }catch(std::exception &e){
-            std::cout << MAGENTA << "[SALE POINT " << sp.id << "] An error occurred while attending clients..." << RESET << std::endl;
-        }
-    }
+    AWAIT(checkNumDrinksPopcorn(mrsp, sp));
+    g_logger.log(LOG_INFO, EV_SALE_POINT_ATTENDED, sp.id, mrsp->id); 
+    recordPhase(g_lat_sale_point, timestamp() - mrsp->served_at); 
+    mrsp->attended = true; 
+    RETURN(mrsp); 
 }
 
 /******************************************************
  * Function name:    checkNumDrinksPopcorn
  * Date created:     22/4/2020
  * Input arguments:  
- * Purpose:          Check number of drinks and popcorn
+ * Purpose:          Check number of drinks and popcorn. If there aren't enough the client waits for the stockers, 
+ *                   when the stock goes under the low-watermark the replenishment is requested without waiting
  * 
  ******************************************************/
-void checkNumDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
-   /*Check number of drinks and popcorn*/
-            std::cout << MAGENTA << "[SALE POINT " << sp.id << "] The client "<< mrsp->id  <<" has requested " << mrsp->num_drinks << " drinks and " << mrsp->num_popcorn << " popcorn" << RESET << std::endl;
-            if((sp.num_popcorn - mrsp->num_drinks <= 0) || (sp.num_popcorn - mrsp->num_popcorn <= 0)){
-                requestReplenisher(mrsp, std::ref(sp)); 
-                std::cout << MAGENTA << "[SALE POINT " << sp.id << "] " << sp.num_drinks << " drinks and " << sp.num_popcorn << " popcorn left" << RESET << std::endl;
-            }else{
-                sp.num_drinks  -= mrsp->num_drinks; 
-                sp.num_popcorn -= mrsp->num_popcorn;
-                std::cout << MAGENTA << "[SALE POINT " << sp.id << "] " << sp.num_drinks << " drinks and " << sp.num_popcorn << " popcorn left" << RESET << std::endl;
+ASYNC(void) checkNumDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
+    /*Check number of drinks and popcorn*/
+    g_logger.log(LOG_INFO, EV_SALE_POINT_REQUEST, sp.id, mrsp->id, mrsp->num_drinks, mrsp->num_popcorn); 
+    if(mrsp->num_drinks > sp.num_replenish || mrsp->num_popcorn > sp.num_replenish){
+        g_logger.log(LOG_INFO, EV_SALE_POINT_REFUSED, sp.id, mrsp->id); /*not even a full sale point can serve it*/
+        RETURN(); 
+    }
+    if(!takeDrinksPopcorn(mrsp, sp)){
+        g_logger.log(LOG_INFO, EV_SALE_POINT_STALL, sp.id, mrsp->id); 
+        long start = timestamp(); 
+        do{
+            requestReplenisher(sp); 
+            AWAIT(waitSignal(sp.replenished)); 
+        }while(!takeDrinksPopcorn(mrsp, sp)); 
+        g_metrics.increment(g_m_stalls); 
+        g_metrics.observe(g_m_stall, timestamp() - start); 
+    }
+    g_metrics.increment(g_m_drinks_sold, mrsp->num_drinks); 
+    g_metrics.increment(g_m_popcorn_sold, mrsp->num_popcorn); 
+    g_logger.log(LOG_DEBUG, EV_SALE_POINT_LEFT, sp.id, sp.num_drinks.load(), sp.num_popcorn.load()); 
+    if(sp.num_drinks.load() <= sp.low_watermark || sp.num_popcorn.load() <= sp.low_watermark){
+        requestReplenisher(sp); /*the stockers replenish it while the sale point goes on selling*/
+    }
 
-                checkPaymentSalePoint(mrsp, std::ref(sp)); 
-            }
-            g_queue_cinema.push(std::move(g_queue_drinkpop.front())); 
-            g_queue_drinkpop.pop();
+    AWAIT(checkPaymentSalePoint(mrsp, sp)); 
+}
+
+/******************************************************
+ * Function name:    takeStock
+ * Date created:     17/10/2026
+ * Input arguments:  stock and quantity
+ * Purpose:          Take the quantity if there is enough stock, the stock never goes under zero
+ * 
+ ******************************************************/
+bool takeStock(std::atomic<int> &stock, int n){
+    int current = stock.load(); 
+    while(current >= n){
+        if(stock.compare_exchange_weak(current, current - n)){
+            return true; 
+        }
+    }
+    return false; 
+}
+
+/******************************************************
+ * Function name:    takeDrinksPopcorn
+ * Date created:     17/10/2026
+ * Input arguments:  request of the client and sale point
+ * Purpose:          Take the drinks and the popcorn of the client or nothing
+ * 
+ ******************************************************/
+bool takeDrinksPopcorn(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
+    if(!takeStock(sp.num_drinks, mrsp->num_drinks)){
+        return false; 
+    }
+    if(!takeStock(sp.num_popcorn, mrsp->num_popcorn)){
+        sp.num_drinks += mrsp->num_drinks; 
+        return false; 
+    }
+    return true; 
 }
 
 /******************************************************
  * Function name:    requestReplenisher
  * Date created:     28/4/2020
  * Input arguments:  
- * Purpose:          Send a request to replenisher
+ * Purpose:          Send a request to the stockers. If the sale point has one in the queue already it is merged with it
  * 
  ******************************************************/
-void requestReplenisher(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
+void requestReplenisher(InfoSalePoint &sp){
+    if(sp.replenishing.exchange(true)){
+        g_metrics.increment(g_m_replenish_merged); 
+        return; 
+    }
     /*Send a request to replenisher*/
-    std::cout << MAGENTA << "[SALE POINT " << sp.id << "] The client " << std::to_string(mrsp->id) << " has requested more drinks and popcorn than there are left" << RESET << std::endl;
-    std::cout << MAGENTA << "[SALE POINT " << sp.id << "] I need replenish drinks and popcorn" << RESET << std::endl;
-    g_queue_request_stock.push(&sp); 
-    g_sem_replenisher.signal(); 
-          
-    sp.num_drinks  -= mrsp->num_drinks; 
-    sp.num_popcorn -= mrsp->num_popcorn;
+    g_logger.log(LOG_INFO, EV_SALE_POINT_REPLENISH, sp.id); 
+    sp.requested_at = timestamp(); 
+    g_stage_stock->submit(&sp); /*It wakes a stocker*/
 }
 
 /******************************************************
@@ -466,84 +2058,128 @@ void requestReplenisher(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
  * Purpose:          Check if the payment was successful 
  * 
  ******************************************************/
-void checkPaymentSalePoint(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
-    g_sem_mutex_payment.lock();  
-        MsgRequestPayment mrp(mrsp->id, priorityAssignment(PAY_SP));
-        g_queue_request_payment.push(&mrp);
-        std::this_thread::sleep_for(std::chrono::milliseconds(400)); /*sleep the thread each time that the client pays drinks and popcorn*/
-        std::cout << MAGENTA << "[SALE POINT " << sp.id << "] I request the client's payment" << std::endl; 
+ASYNC(void) checkPaymentSalePoint(MsgRequestSalePoint *mrsp, InfoSalePoint &sp){
+    g_logger.log(LOG_DEBUG, EV_SALE_POINT_PAYMENT, sp.id); 
 
-        /*Wait confirmation of payment system*/
-        std::unique_lock<std::mutex> ul_wait_payment(g_sem_wait_payment); 
-            g_sem_payment.signal();  
-            bool *p_flag_attended = &(mrp.attended);
-            g_cv_payment.wait(ul_wait_payment, [p_flag_attended] {return *p_flag_attended;});
-            g_sem_mutex_payment.unlock();  
-        ul_wait_payment.unlock();
+    /*Wait confirmation of payment system. If it is rejected the drinks and popcorn go back to the stock*/
+    if(AWAIT(paymentSystem(mrsp->id, PAY_SP))){
+        JournalRecord records[] = {{0, J_STOCK, 0, {sp.id, -mrsp->num_drinks, -mrsp->num_popcorn}, 0}, 
+                                   {0, J_PAYMENT, 0, {mrsp->id, PAY_SP, J_PAY_APPROVED}, 0}}; 
+        journal(records, 2); 
+        g_ledger.append(timestamp() / 1000000, PAY_SP, sp.id, 0, mrsp->num_drinks + mrsp->num_popcorn, 
+                        mrsp->num_drinks * DRINK_PRICE + mrsp->num_popcorn * POPCORN_PRICE); 
+    }else{
+        JournalRecord payment = {0, J_PAYMENT, 0, {mrsp->id, PAY_SP, J_PAY_REJECTED}, 0}; 
+        journal(&payment, 1); 
+        g_logger.log(LOG_INFO, EV_SALE_POINT_REJECTED, sp.id, mrsp->id); 
+        sp.num_drinks  += mrsp->num_drinks; 
+        sp.num_popcorn += mrsp->num_popcorn; 
+        g_metrics.increment(g_m_stock_returned, mrsp->num_drinks + mrsp->num_popcorn); 
+    }
 }
 
 /******************************************************
  * Function name:    replenish
  * Date created:     24/4/2020
- * Input arguments:  
- * Purpose:          It simulate the replenisher. When he receives a request, 
- *                   it replenishes the quantity of drink and popcorn that each sale point has
+ * Input arguments:  sale point and worker of the stage, the stocker
+ * Purpose:          It simulate a stocker. When he receives a request, 
+ *                   it replenishes the quantity of drink and popcorn that each sale point has. 
+ *                   The stage wakes the sale point with the request given back
  * 
  ******************************************************/
-void replenish(){
-    std::cout << RED << "[REPLENISHER] Created and waiting to receive requests" << RESET << std::endl; 
-    while(true){
-        try{   
-            g_sem_replenisher.wait(); 
-            std::this_thread::sleep_for(std::chrono::milliseconds(400)); 
-            std::cout << RED << "[REPLENISHER] I have received a request to replenish a sale point" << RESET << std::endl;
-
-            InfoSalePoint *sp = g_queue_request_stock.front(); 
-            g_queue_request_stock.pop(); 
-            sp->num_drinks  = sp->num_replenish;
-            sp->num_popcorn = sp->num_replenish; 
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(500)); 
-            std::cout << RED << "[REPLENISHER] I have replenished " << sp->num_drinks << " drinks and " << sp->num_popcorn << " popcorn in sale point " << sp->id << RESET << std::endl;  
-        }catch(std::exception &e){
-            std::cout << RED << "[REPLENISHER] An error ocurred while replenishing the sale points" << std::endl; 
-        }
-    }
+ASYNC(InfoSalePoint*) replenish(InfoSalePoint *sp, unsigned id){
+    g_logger.log(LOG_DEBUG, EV_REPLENISHER_REQUEST, id + 1, sp->id); 
+    AWAIT(simulateDelay(g_time_replenish)); 
+
+    /*The sale point is filled up, the drinks and popcorn taken meanwhile are replenished too*/
+    int drinks  = sp->num_replenish - sp->num_drinks.exchange(sp->num_replenish); 
+    int popcorn = sp->num_replenish - sp->num_popcorn.exchange(sp->num_replenish); 
+    JournalRecord stock = {0, J_STOCK, 0, {sp->id, drinks, popcorn}, 0}; 
+    journal(&stock, 1); 
+    long requested_at = sp->requested_at; /*once replenishing is false the sale point can ask again and write it*/
+    sp->replenishing = false; 
+    g_metrics.increment(g_m_replenishments); 
+    g_metrics.increment(g_m_stock_restocked, drinks + popcorn); 
+    recordPhase(g_lat_replenisher, timestamp() - requested_at); 
+
+    g_logger.log(LOG_INFO, EV_REPLENISHER_DONE, id + 1, sp->num_replenish, sp->num_replenish, sp->id); 
+    RETURN(sp); 
 }
 
 /******************************************************
  * Function name:    paymentSystem 
  * Date created:     13/4/2020
- * Input arguments: 
- * Purpose:          It simulate the pay system
+ * Input arguments:  client and type of the payment
+ * Purpose:          It simulate the pay system. The request goes to the payment gateway, which keeps 
+ *                   several authorizations in flight, and the caller only waits for its own payment. 
+ *                   The gateway can signal after the wait ends, so the last of both frees the request
  * 
  ******************************************************/
-void paymentSystem(){
-    std::cout << BLUE << "[PAYMENT SYSTEM] Payment system open" << RESET << std::endl;  
-    while(true){
-        try{
-            g_sem_payment.wait();
-            /*Control the access to payment request queue*/
-            g_sem_mutex_access_payment.lock(); 
-                MsgRequestPayment *mrp = g_queue_request_payment.top();  
-                g_queue_request_payment.pop();
-            g_sem_mutex_access_payment.unlock(); 
-
-            switch(mrp->type){
-                case 1:
-                    std::cout << BLUE << "[PAYMENT SYSTEM] Payment request received. The client " << std::to_string(mrp->id_client) << " has paid tickets" << RESET << std::endl;
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                    break; 
-                case 2:
-                    std::cout << BLUE << "[PAYMENT SYSTEM] Payment request received. The client " << std::to_string(mrp->id_client) << " has paid drinks and popcorn" << RESET << std::endl;
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                    break;
-            }
-            mrp->attended = true;  
-            g_cv_payment.notify_all();
-        }catch(std::exception &e){
-            std::cout << BLUE << "[PAYMENT SYSTEM] An error occurred while attending clients..." << RESET << std::endl;
-        }  
+ASYNC(bool) paymentSystem(int id_client, int type){
+    PaymentWait *pw = g_payment_waits.create(id_client, type); 
+    paymentSystem(&(pw->mrp), [pw](){ 
+        sendSignal(pw->paid); 
+        releasePaymentWait(pw); 
+    }); 
+    AWAIT(waitSignal(pw->paid, g_m_wait_sale_point_payment)); 
+    bool approved = pw->mrp.approved; 
+    releasePaymentWait(pw); 
+    RETURN(approved); 
+}
+
+/******************************************************
+ * Function name:    releasePaymentWait 
+ * Date created:     17/10/2026
+ * Input arguments:  payment a sale point waits for
+ * Purpose:          The sale point or the gateway is done with the payment, the last one gives it back to the pool
+ * 
+ ******************************************************/
+void releasePaymentWait(PaymentWait *pw){
+    if(--(pw->owners) == 0){
+        g_payment_waits.destroy(pw); 
+    }
+}
+
+/******************************************************
+ * Function name:    paymentSystem 
+ * Date created:     17/10/2026
+ * Input arguments:  request to pay and function to run when it ends
+ * Purpose:          The payment goes to the payment gateway and the caller doesn't wait for it. 
+ *                   The function runs in the thread of the gateway with the result in the request
+ * 
+ ******************************************************/
+void paymentSystem(MsgRequestPayment *mrp, std::function<void()> on_done){
+    mrp->requested_at = timestamp(); 
+    mrp->on_paid      = std::move(on_done); 
+    g_gateway->authorize(mrp, [mrp](bool approved){ /*only a pointer, the callback isn't allocated*/
+        recordPhase(g_lat_payment, timestamp() - mrp->requested_at); 
+        mrp->approved = approved; 
+        showPayment(mrp); 
+        std::function<void()> on_paid; 
+        on_paid.swap(mrp->on_paid); /*it can free the request*/
+        on_paid(); 
+    }); 
+}
+
+/******************************************************
+ * Function name:    showPayment 
+ * Date created:     17/10/2026
+ * Input arguments:  request paid
+ * Purpose:          Show the result of the payment
+ * 
+ ******************************************************/
+void showPayment(MsgRequestPayment *mrp){
+    if(!mrp->approved){
+        g_logger.log(LOG_INFO, EV_PAYMENT_REJECTED, mrp->id_client); 
+        return; 
+    }
+    switch(mrp->type){
+        case 1:
+            g_logger.log(LOG_INFO, EV_PAYMENT_TICKETS, mrp->id_client); 
+            break; 
+        case 2:
+            g_logger.log(LOG_INFO, EV_PAYMENT_FOOD, mrp->id_client); 
+            break;
     }
 }
 
@@ -551,22 +2187,51 @@ void paymentSystem(){
  * Function name:    manager
  * Date created:     13/4/2020
  * Input arguments: 
- * Purpose:          Generate the turns to the clients access to ticket office 
+ * Purpose:          Generate the turns to the clients access to ticket office. The clients keep 
+ *                   the FIFO order in the queue of the ticket office of their showing. 
+ *                   The clients refused by the admission control never arrive, so it ends with an empty session
  * 
  ******************************************************/
-void manager(){
-    std::cout << CYAN << "[MANAGER] Manager is ready" << RESET << std::endl;
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+SERVICE manager(){
+    g_logger.log(LOG_INFO, EV_MANAGER_READY); 
+    AWAIT(simulateDelay(200));
     try{
-        for(int i = 1; i <= NUM_CLIENTS; i++){
-                std::cout << CYAN << "[MANAGER] It's the turn of client " << std::to_string(i) << " to buy tickets" << RESET << std::endl; 
-                g_turn_tickets = i; 
-                g_cv_ticket_office.notify_all();  
-                g_sem_manager_tickets.lock(); 
+        while(true){
+                AWAIT(waitSignal(g_sem_clients_arrived, g_m_wait_manager)); 
+                g_sem_mutex_clients.lock(); 
+                    ClientSession *cs = g_queue_tickets.front(); 
+                    g_queue_tickets.pop(); 
+                g_sem_mutex_clients.unlock(); 
+                if(cs == nullptr){ /*The manager ends*/
+                    break; 
+                }
+
+                g_logger.log(LOG_DEBUG, EV_MANAGER_TICKETS_TURN, cs->id); 
+                resumeClient(cs); 
         } 
     }catch(std::exception &e){
-        std::cout << BOLDCYAN << "[MANAGER] An error occurred while generating turns..." << RESET << std::endl;
+        g_logger.log(LOG_ERROR, EV_MANAGER_ERROR); 
     }
+    endService(); 
+}
+
+/******************************************************
+ * Function name:    stopServices
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Close the stages and send an empty request to the other services so they end
+ * 
+ ******************************************************/
+void stopServices(){
+    g_stage_tickets->close(); 
+    g_stage_sale_points->close(); 
+    g_stage_stock->close(); 
+    g_holds_closed = true; 
+    sendSignal(g_sem_holds); 
+    g_sem_mutex_clients.lock(); 
+        g_queue_tickets.push(nullptr); 
+    g_sem_mutex_clients.unlock(); 
+    sendSignal(g_sem_clients_arrived); 
 }
 
 /******************************************************
@@ -580,31 +2245,124 @@ int main(int argc, char *argv[]){
     if(std::signal(SIGINT, signalHandler) == SIG_ERR){ /*It installs the signal handler*/
         std::cout << BOLDWHITE << "[MAIN] ERROR. The signal CRTL+C hasn't been received correctly \n" << RESET << std::endl; 
     } 
+    parseArguments(argc, argv); 
+    g_sessions.setPooled(g_pooled); 
+    g_ticket_payments.setPooled(g_pooled); 
+    g_payment_waits.setPooled(g_pooled); 
+    if(g_seed == 0){
+        g_seed = std::random_device()(); 
+    }
+    Workload workload(g_seed); 
+    if(!workload.setArrivals(g_arrivals, g_arrival_rate) || !workload.setDistributions(g_distributions, MAX_REQUEST_TICKETS - 1, MAX_REQUEST_DRINK_POP - 1)){
+        std::cout << BOLDWHITE << "[MAIN] ERROR. The workload " << g_arrivals << " " << g_distributions << " is not valid" << RESET << std::endl; 
+        return EXIT_FAILURE; 
+    }
+    if(g_group_share < 0 || g_group_share > 1 || g_group_showings < 2 || g_group_showings > MAX_GROUP_SHOWINGS){
+        std::cout << BOLDWHITE << "[MAIN] ERROR. A group order books between 2 and " << MAX_GROUP_SHOWINGS << " showings with -y between 0 and 1" << RESET << std::endl; 
+        return EXIT_FAILURE; 
+    }
+    if(g_num_windows < 1 || g_num_windows > MAX_WINDOWS){
+        std::cout << BOLDWHITE << "[MAIN] ERROR. Each showing has between 1 and " << MAX_WINDOWS << " ticket offices" << RESET << std::endl; 
+        return EXIT_FAILURE; 
+    }
+    workload.setGroups(g_group_share, std::min(g_group_showings, g_num_showings)); 
+    g_workload    = &workload; 
+    g_num_clients = workload.getNumClients(g_num_clients); 
+    RealClock    real_clock(g_time_scale); 
+    VirtualClock virtual_clock; 
+    if(g_virtual_time){
+        g_virtual = &virtual_clock; 
+        g_clock   = &virtual_clock; 
+    }else{
+        g_clock   = &real_clock; 
+    }
 
     messageWelcome();
-    blockSem(); 
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    g_logger.start(g_log_level, g_log_mode, g_log_file); 
+    g_ledger.start(); 
+    g_clock->sleepFor(200 * 1000L); 
+    g_start = std::chrono::steady_clock::now(); 
 
-    std::thread ticket_office(ticketOffice); 
+    ThreadPool pool(g_num_workers); 
+    g_pool = &pool; 
+#ifdef CINEMA_COROUTINES
+    Executor executor(pool, g_clock, g_virtual, g_time_scale); 
+    g_executor = &executor; 
+#endif
+    long latency_us = g_virtual != nullptr ? g_payment_latency * 1000L : static_cast<long>(g_payment_latency * 1000 * g_time_scale); 
+    PaymentGateway gateway(g_payment_window, latency_us, g_payment_distribution, g_payment_failures, 
+                           g_payment_ratio, g_payment_starvation * 1000L, g_virtual, g_seed); 
+    gateway.setPooled(g_pooled); 
+    g_gateway = &gateway; 
+    g_logger.log(LOG_INFO, EV_PAYMENT_OPEN, g_payment_window, g_payment_ratio); 
 
-    InfoSalePoint sp1 = {1, 15, 15, 15};
-    std::thread sale_point1(salePoint, std::ref(sp1)); 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-    InfoSalePoint sp2 = {2, 12, 12, 12};
-    std::thread sale_point2(salePoint, std::ref(sp2)); 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    openShowings(); 
+    registerMetrics(); 
+    openStages(); 
+    if(!g_metrics_file.empty()){
+        g_metrics.start(g_metrics_file, g_metrics_period); 
+    }
+    for(unsigned w = 0; w < g_stage_tickets->getNumWorkers(); w++){
+        g_logger.log(LOG_INFO, EV_TICKET_OFFICE_OPEN, w / g_num_windows + 1); 
+        startService([w](){ return stageWorker(g_stage_tickets, w); }); 
+    }
 
-    InfoSalePoint sp3 = {3, 10, 10, 10};
-    std::thread sale_point3(salePoint, std::ref(sp3)); 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    /*The sale points have 15, 12 and 10 drinks and popcorn in turns*/
+    int stocks[] = {15, 12, 10}; 
+    for(int i = 0; i < g_num_sp; i++){
+        int stock = stocks[i % 3]; 
+        g_sale_points.push_back(new InfoSalePoint(i + 1, stock, stock * g_low_watermark / 100)); 
+    }
+    if(!g_journal_file.empty()){
+        openJournal(); 
+    }
+    for(int i = 0; i < g_num_sp; i++){
+        InfoSalePoint *sp = g_sale_points[i]; 
+        g_logger.log(LOG_INFO, EV_SALE_POINT_CREATED, sp->id, sp->num_drinks.load(), sp->num_popcorn.load()); 
+        startService([i](){ return stageWorker(g_stage_sale_points, i); }); 
+        g_clock->sleepFor(100 * 1000L); 
+    }
 
-    std::thread payment(paymentSystem); 
-    std::thread clients(createClients);
-    std::thread thread_manager(manager); 
-    std::thread replenisher(replenish);  
+    startService(createClients); 
+    startService(manager); 
+    for(int i = 0; i < g_num_stockers; i++){
+        g_logger.log(LOG_INFO, EV_REPLENISHER_CREATED, i + 1); 
+        startService([i](){ return stageWorker(g_stage_stock, i); }); 
+    }
+    if(holdsExpire()){
+        startService(expireHolds); 
+    }
  
-    payment.join();
+    /*Wait until every client is in the cinema or has gone home*/
+    for(int i = 0; i < g_num_clients; i++){
+        waitSignal(g_sem_clients_done); 
+    }
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - g_start; 
+
+    stopServices(); 
+    g_clock->leave(); /*the threads can end their delays while main waits for them*/
+    joinServices(); 
+    gateway.stop(); 
+#ifdef CINEMA_COROUTINES
+    executor.stop(); 
+#endif
+    pool.shutdown(); 
+    g_journal.close(); 
+    g_ledger.stop(); /*every paid sale can be read by the queries of the summary*/
+
+    g_metrics.stop(); 
+    g_logger.stop(); 
+    for(unsigned i = 0; i < g_sale_points.size(); i++){
+        delete g_sale_points[i]; 
+    }
+
+    showSummary(elapsed); 
+    if(!g_results_file.empty()){
+        writeResults(elapsed); 
+    }
+    delete g_stage_tickets; 
+    delete g_stage_sale_points; 
+    delete g_stage_stock; 
 
     return EXIT_SUCCESS; 
-}
\ No newline at end of file
+}
@@ -0,0 +1,68 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    logdump.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Format offline the binary log written by the cinema with the option -B
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Logger.h"
+#include "../include/LogEvents.h"
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:  binary log [maximum level]
+ * Purpose:          Write each record of the log as the line the cinema would have written
+ * 
+ ******************************************************/
+int main(int argc, char *argv[]){
+    if(argc < 2){
+        std::cout << BOLDWHITE << "Usage: " << argv[0] << " <binary log> [level]" << RESET << std::endl; 
+        return EXIT_FAILURE; 
+    }
+    int level = argc > 2 ? std::atoi(argv[2]) : LOG_DEBUG; 
+
+    FILE *in = std::fopen(argv[1], "rb"); 
+    if(in == nullptr){
+        std::cout << BOLDWHITE << "[LOGDUMP] ERROR. The log " << argv[1] << " can't be read" << RESET << std::endl; 
+        return EXIT_FAILURE; 
+    }
+    char magic[sizeof(LOG_MAGIC) - 1]; 
+    int  size = 0; 
+    if(std::fread(magic, 1, sizeof(magic), in) != sizeof(magic) || std::memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0 
+       || std::fread(&size, sizeof(size), 1, in) != 1 || size != sizeof(LogRecord)){
+        std::cout << BOLDWHITE << "[LOGDUMP] ERROR. " << argv[1] << " is not a binary log of this version" << RESET << std::endl; 
+        std::fclose(in); 
+        return EXIT_FAILURE; 
+    }
+
+    LogRecord record; 
+    std::string batch; 
+    while(std::fread(&record, sizeof(record), 1, in) == 1){
+        if(record.event < 0 || record.event >= NUM_LOG_EVENTS || record.level > level){
+            continue; 
+        }
+        record.text[LOG_TEXT_SIZE - 1] = '\0'; 
+        batch += Logger::format(g_log_events, record); 
+        batch += '\n'; 
+        if(batch.size() > (1 << 16)){
+            std::fwrite(batch.data(), 1, batch.size(), stdout); 
+            batch.clear(); 
+        }
+    }
+    std::fwrite(batch.data(), 1, batch.size(), stdout); 
+    std::fclose(in); 
+    return EXIT_SUCCESS; 
+}
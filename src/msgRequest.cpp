@@ -15,18 +15,65 @@
 #include "../include/msgRequest.h"
 
 /*Constructor of class of requests to tickets*/
-MsgRequestTickets::MsgRequestTickets(int id, int ns): id_client(id), num_seats(ns){
-    this -> suff_seats = false; 
+MsgRequestTickets::MsgRequestTickets(int id, int ns, int sh): id_client(id), num_seats(ns), showing(sh), status(REQUEST_IDLE){
+    this -> seats.reserve(ns); 
+    this -> suff_seats   = false; 
+    this -> requested_at = 0; 
+    this -> served_at    = 0; 
 } 
 
+/*The client gives the request to the ticket office*/
+void MsgRequestTickets::post(){
+    this -> status = REQUEST_QUEUED; 
+}
+
+/*It takes the callback out before calling it, the client can free the request as soon as it resumes*/
+void MsgRequestTickets::complete(){
+    std::function<void()> cb; 
+    cb.swap(on_attended); 
+    this -> status = REQUEST_DONE; 
+    if(cb){
+        cb(); 
+    }
+}
+
+/*True while a ticket office owns the request*/
+bool MsgRequestTickets::inFlight(){
+    return this -> status == REQUEST_QUEUED; 
+}
+
 /*Constructor of class of requests to sale point*/
-MsgRequestSalePoint::MsgRequestSalePoint(int id, int nd, int np): id(id), num_drinks(nd), num_popcorn(np){
+MsgRequestSalePoint::MsgRequestSalePoint(int id, int nd, int np): id(id), num_drinks(nd), num_popcorn(np), status(REQUEST_IDLE){
     this -> id_sp_attend = 0; 
     this -> attended     = false;
+    this -> requested_at = 0; 
+    this -> served_at    = 0; 
+}
+
+/*The client gives the request to the sale points*/
+void MsgRequestSalePoint::post(){
+    this -> status = REQUEST_QUEUED; 
+}
+
+/*It takes the callback out before calling it, the client can free the request as soon as it resumes*/
+void MsgRequestSalePoint::complete(){
+    std::function<void()> cb; 
+    cb.swap(on_attended); 
+    this -> status = REQUEST_DONE; 
+    if(cb){
+        cb(); 
+    }
+}
+
+/*True while a sale point owns the request*/
+bool MsgRequestSalePoint::inFlight(){
+    return this -> status == REQUEST_QUEUED; 
 }
 
 /*Constructor of class of requests to pay*/
 MsgRequestPayment::MsgRequestPayment(int id, int t): id_client(id), type(t){
-    this -> attended = false;
+    this -> attended     = false;
+    this -> approved     = false;
+    this -> requested_at = 0; 
 };  
 
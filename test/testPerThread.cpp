@@ -0,0 +1,72 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    testPerThread.cpp
+ 
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Test of the objects of each thread of the Ledger and the Metrics: an instance built at the 
+ *                  address of one that was destroyed starts empty, and a thread that goes from one instance to 
+ *                  another writes in the object it already had
+ * 
+ ******************************************************/
+
+#include <new>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Ledger.h"
+#include "../include/Metrics.h"
+
+#define SWITCHES    10000
+
+/******************************************************
+ * Function name:    check
+ * Date created:     17/10/2026
+ * Input arguments:  name of the check and its result
+ * Purpose:          Show the check and give back if it failed
+ * 
+ ******************************************************/
+int check(std::string name, bool ok){
+    std::cout << BOLDWHITE << "[TEST] " << name << RESET << (ok ? " ok" : " FAILED") << std::endl; 
+    return ok ? 0 : 1; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments: 
+ * Purpose:          Rebuild a ledger in the same storage and switch between two metrics many times
+ * 
+ ******************************************************/
+int main(){
+    int failed = 0; 
+
+    alignas(Ledger) static unsigned char storage[sizeof(Ledger)]; 
+    Ledger *ledger = new(storage) Ledger(); 
+    ledger->append(1, 1, 0, 1, 2, 1000); 
+    ledger->flush(); 
+    ledger->~Ledger(); 
+    ledger = new(storage) Ledger(); 
+    ledger->append(2, 1, 0, 1, 3, 1500); 
+    ledger->flush(); 
+    failed += check("ledger rebuilt at the same address", ledger->getRows() == 1 && ledger->revenue() == 1500); 
+    ledger->~Ledger(); 
+
+    Metrics first; 
+    Metrics second; 
+    int a = first.addCounter("first_total", "first"); 
+    int b = second.addCounter("second_total", "second"); 
+    for(int i = 0; i < SWITCHES; i++){
+        first.increment(a); 
+        second.increment(b); 
+    }
+    failed += check("metrics switched", first.getCounter(a) == SWITCHES && second.getCounter(b) == SWITCHES); 
+    failed += check("one shard per instance", first.getShards() == 1 && second.getShards() == 1); 
+
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE; 
+}
@@ -0,0 +1,69 @@
+/******************************************************
+ * Project:         Práctica 3 de Sistemas Operativos II
+ * 
+ * Program name:    testWorkload.cpp
+
+ * Author:          María Espinosa Astilleros
+ * 
+ * Date created:    17/10/2026
+ * 
+ * Purpose:         Test of the trace of the workload: a row with more seats, drinks or popcorn than a request
+ *                  can have is cut to the maximum of its distribution, the rest of the rows are kept
+ * 
+ ******************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+#include "../include/color.h"
+#include "../include/Workload.h"
+
+#define MAX_SEATS   5
+#define MAX_FOOD    9
+#define TRACE_FILE  "/tmp/testWorkload.csv"
+
+/******************************************************
+ * Function name:    check
+ * Date created:     17/10/2026
+ * Input arguments:  name of the check and its result
+ * Purpose:          Show the check and give back if it failed
+ * 
+ ******************************************************/
+int check(std::string name, bool ok){
+    std::cout << BOLDWHITE << "[TEST] " << name << RESET << (ok ? " ok" : " FAILED") << std::endl; 
+    return ok ? 0 : 1; 
+}
+
+/******************************************************
+ * Function name:    main
+ * Date created:     17/10/2026
+ * Input arguments:
+ * Purpose:          Load a trace with a row out of range and check every arrival of it
+ * 
+ ******************************************************/
+int main(){
+    std::ofstream out(TRACE_FILE); 
+    out << "# time_ms,showing,seats,drinks,popcorn\n"; 
+    out << "0,1,3,2,4\n"; 
+    out << "10,1,26,40,1000\n"; 
+    out << "20,2,5,9,9\n"; 
+    out.close(); 
+
+    Workload workload(1); 
+    int failed = 0; 
+    failed += check("trace loaded", workload.setArrivals(std::string("trace:") + TRACE_FILE, 1)); 
+    failed += check("distributions", workload.setDistributions("uniform:1:5/uniform:1:9/uniform:1:9", MAX_SEATS, MAX_FOOD)); 
+    failed += check("three clients", workload.getNumClients(0) == 3); 
+
+    Arrival a = workload.next(2); 
+    failed += check("row in range kept", a.seats == 3 && a.drinks == 2 && a.popcorn == 4); 
+    a = workload.next(2); 
+    failed += check("row out of range cut", a.seats == MAX_SEATS && a.drinks == MAX_FOOD && a.popcorn == MAX_FOOD); 
+    a = workload.next(2); 
+    failed += check("row at the maximum kept", a.showing == 2 && a.seats == MAX_SEATS && a.drinks == MAX_FOOD && a.popcorn == MAX_FOOD); 
+
+    std::remove(TRACE_FILE); 
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE; 
+}